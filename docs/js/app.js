@@ -143,6 +143,8 @@ const searchIndex = [
     { method: 'ledNoBlink(x, y)', description: 'Stop blinking LED at (x,y) and turn it off', page: 'led-blink', category: 'LED Blink' },
     { method: 'ledNoBlink(index)', description: 'Stop blinking LED by linear index', page: 'led-blink', category: 'LED Blink' },
     { method: 'ledNoBlink()', description: 'Stop all LEDs from blinking', page: 'led-blink', category: 'LED Blink' },
+    { method: 'ledBlinkMask(mask, rateMs)', description: 'Blink a group of LEDs together at one rate', page: 'led-blink', category: 'LED Blink' },
+    { method: 'ledNoBlinkMask(mask)', description: 'Stop blinking a group of LEDs and turn them off', page: 'led-blink', category: 'LED Blink' },
     { method: 'ledUpdate()', description: 'Process blink timers — call every loop', page: 'led-blink', category: 'LED Blink' },
     
     // Animation Mode
@@ -198,6 +200,8 @@ const searchIndex = [
     { method: 'getRotation()', description: 'Get current rotation in degrees', page: 'canvas-mode', category: 'Canvas Mode' },
     { method: 'setInvert(bool)', description: 'Invert all pixels on display', page: 'canvas-mode', category: 'Canvas Mode' },
     { method: 'getInvert()', description: 'Check if display is inverted', page: 'canvas-mode', category: 'Canvas Mode' },
+    { method: 'setGrayscale(bits)', description: 'Brightness levels: 2 bits per pixel (4 levels), 0 = on/off', page: 'canvas-mode', category: 'Canvas Mode' },
+    { method: 'setBrightness(value)', description: 'Global brightness 0-255 (grayscale mode)', page: 'canvas-mode', category: 'Canvas Mode' },
     { method: 'width()', description: 'Get matrix width (12)', page: 'canvas-mode', category: 'Canvas Mode' },
     { method: 'height()', description: 'Get matrix height (8)', page: 'canvas-mode', category: 'Canvas Mode' },
     
@@ -737,6 +741,11 @@ screen.show();              // Push once</code></pre>
             Unlike the other Simple LED functions, blink requires <code>ledUpdate()</code> to be called every <code>loop()</code> to process the blink timers.
         </div>
 
+        <div class="info-box note">
+            <strong>How many LEDs can blink</strong>
+            With <code>ledBlink()</code>, all 96 LEDs can blink at once, each at its own rate (rates up to 65535 ms). A <code>TinyScreen</code> object holds 32 blink timers (<code>MAX_BLINKS</code>); declare it as <code>TinyScreenT&lt;5, 96&gt; screen;</code> to blink every LED, or with fewer timers to save RAM (8 bytes each). Its <code>blink()</code> returns <code>false</code> when every timer is in use.
+        </div>
+
         <h2>Setup</h2>
         <pre><code class="language-cpp">#include "TinyFilmFestival.h"
 
@@ -791,9 +800,30 @@ ledBlink(95, 750);       // Last LED, 750ms blink</code></pre>
             <pre><code class="language-cpp">ledNoBlink();        // Cancel all blinks (static LEDs unaffected)</code></pre>
         </div>
 
+        <div class="api-method">
+            <h3>ledBlinkMask(mask, rateMs, phaseLock)</h3>
+            <p>Blink a whole group of LEDs together. <code>mask</code> is a frame (<code>uint32_t[3]</code>, the same format as an animation frame) with the LEDs to blink turned on. All LEDs blinking at the same rate share one timer and toggle together in a single step, so large regions stay perfectly in sync. LEDs added later at a rate that is already blinking join that group in step.</p>
+            <p>A new group starts ON. With <code>phaseLock</code> set to <code>true</code> it instead toggles on whole multiples of <code>rateMs</code> since startup, so groups started at different times (or at rates like 250 and 500 ms) line up. Up to 4 different rates (<code>MAX_BLINK_GROUPS</code>) can blink at once.</p>
+            <table>
+                <tr><th>Parameter</th><th>Type</th><th>Description</th></tr>
+                <tr><td>mask</td><td>const uint32_t[3]</td><td>LEDs to blink</td></tr>
+                <tr><td>rateMs</td><td>unsigned long</td><td>Toggle interval in milliseconds</td></tr>
+                <tr><td>phaseLock</td><td>bool</td><td>Align toggles to the shared clock (default <code>false</code>)</td></tr>
+            </table>
+            <pre><code class="language-cpp">const uint32_t warning[3] = {0xFC0FC000, 0x00000000, 0x00000000};
+
+ledBlinkMask(warning, 250, true);   // Top-left block, locked to the 250 ms grid</code></pre>
+        </div>
+
+        <div class="api-method">
+            <h3>ledNoBlinkMask(mask)</h3>
+            <p>Stop blinking every LED in <code>mask</code> (group or individual) and turn them OFF.</p>
+            <pre><code class="language-cpp">ledNoBlinkMask(warning);</code></pre>
+        </div>
+
         <div class="api-method">
             <h3>ledUpdate()</h3>
-            <p>Process all blink timers. <strong>Must be called every <code>loop()</code>.</strong> Only writes to the display when a blink state actually changes, so it is very efficient.</p>
+            <p>Process all blink timers. <strong>Must be called every <code>loop()</code>.</strong> Blinkers are kept in order of their next toggle, so each call only looks at the LEDs that are due, and the display is only written when a blink state actually changes.</p>
             <pre><code class="language-cpp">void loop()
 {
     ledUpdate();
@@ -1108,7 +1138,7 @@ screen.setPosition(x, y);</code></pre>
 
         <div class="info-box note">
             <strong>Monochrome Matrix</strong>
-            The LED matrix is on/off only — no color or brightness. Use <code>ON</code> and <code>OFF</code> constants.
+            The LED matrix is on/off only — no color. Use <code>ON</code> and <code>OFF</code> constants. For brightness levels, declare the screen as <code>TinyScreenGray</code> and call <code>setGrayscale(2)</code> after <code>begin()</code>; the brightest channel of a color then sets the level.
         </div>
 
         <h2>Setup</h2>
@@ -1248,6 +1278,7 @@ screen.setRotation(90);    // Rotated 90° clockwise
 screen.setRotation(180);   // Upside down
 screen.setRotation(270);   // Rotated 270° clockwise</code></pre>
             <p><strong>Note:</strong> 90° and 270° rotations use a centered crop because the matrix is 12x8 (non-square).</p>
+            <p>Rotation applies to canvas drawing, overlays and animations played with <code>play()</code> / <code>playOnLayer()</code>.</p>
         </div>
 
         <div class="api-method">
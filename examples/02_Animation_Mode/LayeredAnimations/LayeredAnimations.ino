@@ -3,9 +3,12 @@
  * 02_Animation_Mode/LayeredAnimations
  * 
  * Play multiple animations simultaneously using TinyScreen layers.
- * Each layer runs independently with its own speed and playback mode.
+ * Each layer runs with its own speed and playback mode.
  * Layers are combined (OR'd) when displayed.
  * 
+ * Both layers follow the screen's timeline (master clock), so they stay
+ * in step however long the sketch runs.
+ * 
  * Animation files (.h) are created using the Arduino LED Matrix Editor:
  * https://ledmatrix-editor.arduino.cc/
  * 
@@ -49,13 +52,17 @@ void setup()
     Serial.begin(9600);
     screen.begin();
     
+    // Add a second layer for foreground
+    fgLayer = screen.addLayer();
+    
+    // Both layers take their timing from one clock
+    screen.followTimeline();
+    screen.followTimelineOnLayer(fgLayer);
+    
     // Layer 0 (primary) - Background, slow looping
     screen.play(bgAnim, LOOP);
     screen.setSpeed(150);
     
-    // Add a second layer for foreground
-    fgLayer = screen.addLayer();
-    
     // Configure foreground layer (fast, boomerang)
     screen.playOnLayer(fgLayer, fgAnim, BOOMERANG);
     screen.setSpeedOnLayer(fgLayer, 60);
@@ -0,0 +1,83 @@
+/*
+ * TinyFilmFestival V2 - Pressure Scrub
+ * 02_Animation_Mode/Pressure_Scrub
+ * 
+ * Map pressure sensor values to a position in the animation.
+ * No pressure = first frame, full pressure = last frame.
+ * 
+ * Hardware:
+ * - Arduino UNO R4 WiFi (built-in 12×8 LED Matrix)
+ * - FSR (Force Sensitive Resistor) on analog pin A0
+ * - 10K pull-down resistor
+ * 
+ * Concept: MAP
+ * Instead of changing how fast the animation plays, the sensor picks
+ * where in the animation to be. seekToFraction() takes 0.0 - 1.0 and
+ * finds the frame at that point in time, using each frame's duration.
+ * DESCRIBE_ANIMATION works those durations out while the sketch compiles
+ * (idle.h says constexpr instead of const for this), so each seek is a
+ * quick lookup however many frames the animation has.
+ * 
+ * LED Matrix Layout (12 columns x 8 rows):
+ * 
+ *      x=0  x=1  x=2  x=3  x=4  x=5  x=6  x=7  x=8  x=9  x=10 x=11
+ *     +----+----+----+----+----+----+----+----+----+----+----+----+
+ * y=0 |  0 |  1 |  2 |  3 |  4 |  5 |  6 |  7 |  8 |  9 | 10 | 11 |
+ *     +----+----+----+----+----+----+----+----+----+----+----+----+
+ * y=1 | 12 | 13 | 14 | 15 | 16 | 17 | 18 | 19 | 20 | 21 | 22 | 23 |
+ *     +----+----+----+----+----+----+----+----+----+----+----+----+
+ * y=2 | 24 | 25 | 26 | 27 | 28 | 29 | 30 | 31 | 32 | 33 | 34 | 35 |
+ *     +----+----+----+----+----+----+----+----+----+----+----+----+
+ * y=3 | 36 | 37 | 38 | 39 | 40 | 41 | 42 | 43 | 44 | 45 | 46 | 47 |
+ *     +----+----+----+----+----+----+----+----+----+----+----+----+
+ * y=4 | 48 | 49 | 50 | 51 | 52 | 53 | 54 | 55 | 56 | 57 | 58 | 59 |
+ *     +----+----+----+----+----+----+----+----+----+----+----+----+
+ * y=5 | 60 | 61 | 62 | 63 | 64 | 65 | 66 | 67 | 68 | 69 | 70 | 71 |
+ *     +----+----+----+----+----+----+----+----+----+----+----+----+
+ * y=6 | 72 | 73 | 74 | 75 | 76 | 77 | 78 | 79 | 80 | 81 | 82 | 83 |
+ *     +----+----+----+----+----+----+----+----+----+----+----+----+
+ * y=7 | 84 | 85 | 86 | 87 | 88 | 89 | 90 | 91 | 92 | 93 | 94 | 95 |
+ *     +----+----+----+----+----+----+----+----+----+----+----+----+
+ */
+
+#include "TinyFilmFestival.h"
+#include "idle.h"
+
+TinyScreen screen;
+DESCRIBE_ANIMATION(idleAnim, idle);
+
+int pressurePin = A0;
+
+void setup()
+{
+    Serial.begin(9600);
+    screen.begin();
+    screen.play(idleAnim, LOOP);
+    screen.pause();    // The sensor moves the animation, not the clock
+    Serial.println("Pressure Scrub Demo");
+    Serial.println("Press harder = further into the animation");
+}
+
+void loop()
+{
+    int pressure = analogRead(pressurePin);
+    
+    // Map pressure (0-1023) to a position (0.0 - 1.0)
+    float position = pressure / 1023.0;
+    screen.seekToFraction(position);
+    
+    // Debug output (less frequent to not spam serial)
+    static unsigned long lastPrint = 0;
+    if (millis() - lastPrint > 200)
+    {
+        Serial.print("Pressure: ");
+        Serial.print(pressure);
+        Serial.print(" -> frame ");
+        Serial.print(screen.getCurrentFrame());
+        Serial.print(" of ");
+        Serial.println(screen.getTotalFrames());
+        lastPrint = millis();
+    }
+    
+    screen.update();
+}
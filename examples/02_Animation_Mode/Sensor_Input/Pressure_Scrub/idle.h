@@ -0,0 +1,26 @@
+constexpr uint32_t idle[][4] = {
+	{
+		0x80280,
+		0x25542a88,
+		0x2802000,
+		300
+	},
+	{
+		0x802ff,
+		0xed56ffe8,
+		0x2802000,
+		150
+	},
+	{
+		0x4017f,
+		0xf6ab7ff4,
+		0x1401000,
+		150
+	},
+	{
+		0x802ff,
+		0xed56ffe8,
+		0x2802000,
+		150
+	}
+};
@@ -6,7 +6,7 @@
  * A character on the LED matrix reacts to proximity:
  * 
  *   FAR (>60cm):      Sleeping - slow idle animation, dim
- *   MEDIUM (30-60cm): Alert - normal speed idle
+ *   MEDIUM (30-60cm): Alert - wakes with a quick "go", then normal speed idle
  *   CLOSE (15-30cm):  Excited - fast "go" animation + sparkle overlay
  *   VERY CLOSE (<15cm): Overwhelmed - animation pauses, warning flash
  * 
@@ -58,7 +58,8 @@
 UltraSonicDistanceSensor sensor(14, 15, 200);  // trigger, echo, maxDistance
 
 // === TinyScreen - Unified Interface ===
-TinyScreen screen;
+// One layer, with a queue slot so waking up can chain go into idle
+TinyScreenT<1, MAX_BLINKS, 1> screen;
 Animation idleAnim = idle;
 Animation goAnim = go;
 
@@ -178,7 +179,16 @@ void onStateChange()
             break;
             
         case ALERT:
-            screen.play(idleAnim, LOOP);
+            if (previousState == SLEEPING)
+            {
+                // Wake up: one quick run of go, then idle (update() chains them)
+                screen.play(goAnim, ONCE);
+                screen.queue(idleAnim, LOOP);
+            }
+            else
+            {
+                screen.play(idleAnim, LOOP);
+            }
             screen.setSpeed(100);  // Normal speed
             break;
             
@@ -0,0 +1,269 @@
+// BenchCases.h
+// Rendering hot-path benchmarks for TinyScreen
+//
+// Shared by the Benchmark sketch (cycles/call from the DWT cycle counter
+// on the RA4M1) and the host build in extras/host (ns/call).
+// Each case runs `iterations` calls and reports the average cost per call.
+#pragma once
+
+#include "TinyFilmFestival.h"
+#include "idle.h"
+
+//------------------------------------------------------------------------------
+// Timer
+//------------------------------------------------------------------------------
+#if defined(ARDUINO)
+// Cortex-M4 DWT cycle counter
+typedef uint32_t BenchTicks;
+static const char* const BENCH_UNIT = "cycles";
+
+inline void benchTimerBegin() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+inline BenchTicks benchNow() { return DWT->CYCCNT; }
+
+// Let ms of real time pass
+inline void benchStep(unsigned long ms) { delay(ms); }
+
+inline void benchPrepare(TinyScreenBase& screen) { (void)screen; }
+#else
+// Host: nanoseconds, provided by the host bench driver
+typedef uint64_t BenchTicks;
+static const char* const BENCH_UNIT = "ns";
+
+void benchTimerBegin();
+BenchTicks benchNow();
+
+// Move the simulated clock ms forward
+inline void benchStep(unsigned long ms) { host::advanceMillis(ms); }
+
+// Don't let the simulated matrix record every frame
+inline void benchPrepare(TinyScreenBase& screen) { screen.getMatrix().setCapture(false); }
+#endif
+
+typedef void (*BenchReport)(const char* name, float perCall, const char* unit);
+
+// Keeps results observable so the compiler can't drop the work
+static volatile uint32_t benchSink = 0;
+
+#define BENCH_RUN(name, iterations, body) do { \
+    BenchTicks _start = benchNow(); \
+    for (int _i = 0; _i < (iterations); _i++) { body; } \
+    BenchTicks _elapsed = benchNow() - _start; \
+    report(name, (float)_elapsed / (float)(iterations), BENCH_UNIT); \
+} while (0)
+
+// Like BENCH_RUN, but stepMs passes before every call so the frame or scroll
+// step it names is due, rather than timing update()'s nothing-due early exit
+#if defined(ARDUINO)
+#define BENCH_RUN_DUE(name, iterations, stepMs, body) do { \
+    BenchTicks _elapsed = 0; \
+    for (int _i = 0; _i < (iterations); _i++) { \
+        benchStep(stepMs); \
+        BenchTicks _start = benchNow(); \
+        body; \
+        _elapsed += benchNow() - _start; \
+    } \
+    report(name, (float)_elapsed / (float)(iterations), BENCH_UNIT); \
+} while (0)
+#else
+// Moving the simulated clock costs a few ns, so it stays in the timed loop
+#define BENCH_RUN_DUE(name, iterations, stepMs, body) \
+    BENCH_RUN(name, iterations, benchStep(stepMs); body)
+#endif
+
+//------------------------------------------------------------------------------
+// Shared screen
+//------------------------------------------------------------------------------
+// On the board every begin() claims a hardware timer for the LED scan that is
+// never released, with the screen as its interrupt context, so all cases use
+// this one screen (with grayscale, for the grayscale case) and reset it.
+static TinyScreenGray benchScreen;
+
+// idle's frames at 3 ms each, so a short clock step makes the next one due
+static const uint32_t benchQuick[][4] = {
+    {0x80280, 0x25542a88, 0x2802000, 3},
+    {0x802ff, 0xed56ffe8, 0x2802000, 3},
+    {0x4017f, 0xf6ab7ff4, 0x1401000, 3},
+    {0x802ff, 0xed56ffe8, 0x2802000, 3}
+};
+
+// Blank display, every layer stopped at normal speed, no blinks or grayscale
+inline void benchReset() {
+    TinyScreenGray& screen = benchScreen;
+    for (int layer = 0; layer < screen.getLayerCapacity(); layer++) {
+        screen.setSpeedOnLayer(layer, 1.0f);   // A multiplier, unlike setSpeed(ms), ends with the run
+        screen.stopLayer(layer);
+        screen.setBrightnessOnLayer(layer, 255);
+    }
+    static const uint32_t all[3] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
+    screen.noBlinkMask(all);
+    screen.setGrayscale(0);
+    screen.setBrightness(255);
+    screen.setRotation(0);
+    screen.setScrollSpeed(100);
+    screen.resetScroll();
+    screen.beginDraw();
+    screen.clear();
+    screen.endDraw();
+}
+
+//------------------------------------------------------------------------------
+// Cases
+//------------------------------------------------------------------------------
+
+inline void benchUpdateLayers(BenchReport report, int iterations) {
+    static const char* const names[] = {
+        "update() 1 layer", "update() 2 layers", "update() 3 layers",
+        "update() 4 layers", "update() 5 layers"
+    };
+    TinyScreenGray& screen = benchScreen;
+    for (int count = 1; count <= 5; count++) {
+        benchReset();
+        for (int layer = 0; layer < count; layer++) {
+            screen.playOnLayer(layer, idle, LOOP);
+            screen.setSpeedOnLayer(layer, 1);   // A new frame every ms
+        }
+        BENCH_RUN_DUE(names[count - 1], iterations, 1, screen.update());
+    }
+}
+
+inline void benchSpeed(BenchReport report, int iterations) {
+    AnimationLayer layer;
+    layer.start(benchQuick, LOOP, 0, 0);
+
+    float multiplier = 0.5f;
+    BENCH_RUN("setSpeed(float)", iterations,
+        layer.setSpeed(multiplier); multiplier += 0.001f);
+
+    // 3 ms frames at 1.5x: every 2 ms step makes a frame due
+    layer.setSpeed(1.5f);
+    BENCH_RUN_DUE("updateFrame() float speed", iterations, 2,
+        benchSink += layer.updateFrame());
+}
+
+inline void benchGetFrame(BenchReport report, int iterations) {
+    AnimationLayer layer;
+    uint32_t frame[3];
+    layer.start(idle, LOOP, 0, 0);
+
+    BENCH_RUN("getFrame() no offset", iterations,
+        layer.getFrame(frame); benchSink += frame[1]);
+
+    // Alternating offsets invalidate the positioned-frame memo, so every
+    // call shifts the frame
+    int n = 0;
+    BENCH_RUN("getFrame() offset", iterations,
+        layer.setOffset(2 + ((++n) & 1), 2); layer.getFrame(frame); benchSink += frame[1]);
+
+    layer.setOffset(3, 2);
+    BENCH_RUN("getFrame() offset, memo hit", iterations,
+        layer.getFrame(frame); benchSink += frame[1]);
+}
+
+inline void benchRotation(BenchReport report, int iterations) {
+    static const char* const names[] = {
+        "endDraw() rotation 0", "endDraw() rotation 90",
+        "endDraw() rotation 180", "endDraw() rotation 270"
+    };
+    TinyScreenGray& screen = benchScreen;
+    benchReset();
+    screen.beginDraw();
+    screen.clear();
+    screen.fill(ON);
+    screen.rect(1, 1, 6, 4);
+    screen.endDraw();
+
+    for (int r = 0; r < 4; r++) {
+        screen.setRotation(r * 90);
+        BENCH_RUN(names[r], iterations, screen.beginDraw(); screen.endDraw());
+    }
+}
+
+inline void benchShapes(BenchReport report, int iterations) {
+    TinyScreenGray& screen = benchScreen;
+    benchReset();
+    screen.beginDraw();
+    screen.stroke(ON);
+    screen.fill(ON);
+
+    BENCH_RUN("circle() filled d=7", iterations, screen.circle(6, 4, 7));
+    BENCH_RUN("ellipse() filled 11x7", iterations, screen.ellipse(6, 4, 11, 7));
+    BENCH_RUN("rect() filled 10x6", iterations, screen.rect(1, 1, 10, 6));
+    screen.endDraw();
+}
+
+inline void benchScrollText(BenchReport report, int iterations) {
+    TinyScreenGray& screen = benchScreen;
+    benchReset();
+    screen.setScrollSpeed(1);
+
+    BENCH_RUN_DUE("scrollText() 12 chars", iterations, 1,
+        screen.beginDraw(); screen.clear(); screen.scrollText("TINY FILM 25", 1); screen.endDraw());
+}
+
+inline void benchBlinks(BenchReport report, int iterations) {
+    TinyScreenGray& screen = benchScreen;
+    benchReset();
+
+    BENCH_RUN("updateBlinks() 0 LEDs", iterations, screen.updateBlinks());
+
+    // 8 ms rates started 1 ms apart: one LED is due at every 1 ms step
+    for (int i = 0; i < 8; i++) {
+        benchStep(1);
+        screen.blink(i * 12 + i, 8);
+    }
+    BENCH_RUN_DUE("updateBlinks() 8 LEDs", iterations, 1, screen.updateBlinks());
+
+    // Half the matrix in one rate group, toggled at every step
+    static const uint32_t half[3] = {0xFFFFFFFF, 0xFFFF0000, 0x00000000};
+    screen.noBlink();
+    screen.blinkMask(half, 1);
+    BENCH_RUN_DUE("updateBlinks() 48 LED mask", iterations, 1, screen.updateBlinks());
+}
+
+inline void benchGrayscale(BenchReport report, int iterations) {
+    TinyScreenGray& screen = benchScreen;
+    benchReset();
+    screen.setGrayscale(2);
+    int layer = 1;
+    screen.play(idle, LOOP);
+    screen.playOnLayer(layer, idle, LOOP);
+    screen.setBrightnessOnLayer(layer, 100);
+
+    BENCH_RUN("update() 2 layers grayscale", iterations,
+        screen.setBrightnessOnLayer(layer, 100); screen.update());
+
+    screen.stop();
+    screen.stopLayer(layer);
+    screen.beginDraw();
+    screen.clear();
+    screen.fill(0x808080);
+    screen.rect(1, 1, 10, 6);
+    screen.endDraw();
+
+    int n = 0;
+    BENCH_RUN("endDraw() grayscale 2 bits", iterations,
+        screen.beginDraw(); screen.set(0, 0, (++n) & 1); screen.endDraw());
+    BENCH_RUN("setBrightness() 2 bits", iterations,
+        screen.setBrightness((++n) & 0xFF));
+    screen.setGrayscale(0);
+}
+
+inline void runBenchmarks(BenchReport report, int iterations) {
+    benchTimerBegin();
+    benchScreen.begin();
+    benchPrepare(benchScreen);
+    while (benchScreen.addLayer() >= 0) {}
+    benchUpdateLayers(report, iterations);
+    benchSpeed(report, iterations);
+    benchGetFrame(report, iterations);
+    benchRotation(report, iterations);
+    benchShapes(report, iterations);
+    benchScrollText(report, iterations);
+    benchBlinks(report, iterations);
+    benchGrayscale(report, iterations);
+}
@@ -0,0 +1,57 @@
+/*
+ * TinyFilmFestival - Rendering Benchmark
+ *
+ * Measures the cost of the library's hot paths so revisions can be
+ * compared. Results are printed once to the Serial Monitor in CPU cycles
+ * per call (48 cycles = 1 microsecond on the UNO R4).
+ *
+ * Hardware: Arduino UNO R4 WiFi
+ *
+ * Covered:
+ *   update() with 1-5 layers, setSpeed(float) and updateFrame() at a
+ *   float speed, getFrame() with/without offset (shifted, and reused),
+ *   endDraw() at each rotation, filled circle/ellipse/rect,
+ *   scrollText() and updateBlinks()
+ *
+ * The update(), updateFrame(), scrollText() and updateBlinks() cases wait
+ * 1-2 ms before each call so a frame, scroll step or blink is always due;
+ * only the call itself is timed. Every case shares one screen, since each
+ * begin() claims a hardware timer that is never given back.
+ *
+ * The same cases run on a desktop through the host build
+ * (extras/host), which reports nanoseconds per call instead.
+ */
+
+#include "TinyFilmFestival.h"
+#include "BenchCases.h"
+
+const int ITERATIONS = 1000;
+
+void printResult(const char* name, float perCall, const char* unit)
+{
+    Serial.print(name);
+    Serial.print(": ");
+    Serial.print(perCall, 1);
+    Serial.print(" ");
+    Serial.println(unit);
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial && millis() < 3000);
+
+    Serial.println("=== TinyFilmFestival Benchmark ===");
+    Serial.print("Iterations per case: ");
+    Serial.println(ITERATIONS);
+    Serial.println();
+
+    runBenchmarks(printResult, ITERATIONS);
+
+    Serial.println();
+    Serial.println("Done.");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,35 @@
+// bench_main.cpp
+// Host driver for the Benchmark sketch cases (ns/call, wall clock)
+//
+//   tinyscreen_bench [iterations]
+#include <stdio.h>
+#include <chrono>
+#include "BenchCases.h"
+
+static std::chrono::steady_clock::time_point benchEpoch;
+
+void benchTimerBegin() {
+    benchEpoch = std::chrono::steady_clock::now();
+}
+
+BenchTicks benchNow() {
+    return (BenchTicks)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - benchEpoch).count();
+}
+
+static void printResult(const char* name, float perCall, const char* unit) {
+    printf("%-28s %10.1f %s\n", name, perCall, unit);
+}
+
+int main(int argc, char** argv) {
+    int iterations = 100000;
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) iterations = 1;
+    }
+
+    printf("=== TinyFilmFestival Benchmark (host) ===\n");
+    printf("Iterations per case: %d\n\n", iterations);
+    runBenchmarks(printResult, iterations);
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Arduino.h (host shim)
+// Minimal stand-in for the Arduino core so TinyScreen can be compiled
+// and tested on a desktop machine. Only what the library uses is here.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define HIGH 0x1
+#define LOW  0x0
+
+// No separate flash address space on the host
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+
+template<class T, class L>
+auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) {
+    return (b < a) ? b : a;
+}
+
+template<class T, class L>
+auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) {
+    return (a < b) ? b : a;
+}
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+//------------------------------------------------------------------------------
+// Simulated clock
+//------------------------------------------------------------------------------
+// millis()/micros() read a virtual clock that only moves when a test or
+// benchmark moves it, so playback is deterministic and runs at full speed.
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+namespace host {
+    void setMicros(unsigned long us);                // Jump the clock to an absolute time
+    void setMillis(unsigned long ms);
+    void advanceMicros(unsigned long us);            // Move the clock forward
+    void advanceMillis(unsigned long ms);
+}
+
+//------------------------------------------------------------------------------
+// String - just enough of the Arduino String class
+//------------------------------------------------------------------------------
+class String {
+private:
+    std::string s;
+
+public:
+    String() {}
+    String(const char* str) : s(str ? str : "") {}
+    String(const std::string& str) : s(str) {}
+    String(int n) : s(std::to_string(n)) {}
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned int length() const { return (unsigned int)s.length(); }
+
+    String& operator+=(const String& other) { s += other.s; return *this; }
+    String operator+(const String& other) const { return String(s + other.s); }
+    bool operator==(const String& other) const { return s == other.s; }
+};
+
+//------------------------------------------------------------------------------
+// Print - base class used by ArduinoGraphics text output
+//------------------------------------------------------------------------------
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+
+    size_t write(const char* str) {
+        size_t n = 0;
+        while (*str) n += write((uint8_t)*str++);
+        return n;
+    }
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(const String& str) { return write(str.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n) { return write(std::to_string(n).c_str()); }
+    size_t println() { return write("\r\n"); }
+    size_t println(const char* str) { return print(str) + println(); }
+    size_t println(const String& str) { return print(str) + println(); }
+};
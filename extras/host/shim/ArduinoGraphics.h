@@ -0,0 +1,54 @@
+// ArduinoGraphics.h (host shim)
+// Stand-in for the ArduinoGraphics library. TinyScreen does its own
+// buffered drawing, so the style and text calls here only record state.
+#pragma once
+
+#include "Arduino.h"
+
+enum {
+    NO_SCROLL,
+    SCROLL_LEFT,
+    SCROLL_RIGHT,
+    SCROLL_UP,
+    SCROLL_DOWN,
+};
+
+struct Font {
+    int width;
+    int height;
+    const uint8_t* const* data;
+};
+
+extern const Font Font_4x6;
+extern const Font Font_5x7;
+
+class ArduinoGraphics : public Print {
+private:
+    int _width;
+    int _height;
+
+public:
+    ArduinoGraphics(int width, int height) : _width(width), _height(height) {}
+    virtual ~ArduinoGraphics() {}
+
+    int width() { return _width; }
+    int height() { return _height; }
+
+    void stroke(uint32_t color) { (void)color; }
+    void stroke(uint8_t r, uint8_t g, uint8_t b) { (void)r; (void)g; (void)b; }
+    void noStroke() {}
+    void fill(uint32_t color) { (void)color; }
+    void fill(uint8_t r, uint8_t g, uint8_t b) { (void)r; (void)g; (void)b; }
+    void noFill() {}
+    void background(uint32_t color) { (void)color; }
+    void background(uint8_t r, uint8_t g, uint8_t b) { (void)r; (void)g; (void)b; }
+
+    void textFont(const Font& font) { (void)font; }
+    void beginText(int x = 0, int y = 0) { (void)x; (void)y; }
+    void beginText(int x, int y, uint8_t r, uint8_t g, uint8_t b) { (void)x; (void)y; (void)r; (void)g; (void)b; }
+    void beginText(int x, int y, uint32_t color) { (void)x; (void)y; (void)color; }
+    void endText(int scrollDirection = NO_SCROLL) { (void)scrollDirection; }
+    void textScrollSpeed(unsigned long speed) { (void)speed; }
+
+    virtual size_t write(uint8_t c) { (void)c; return 1; }
+};
@@ -0,0 +1,83 @@
+// Arduino_LED_Matrix.h (host shim)
+// Simulated UNO R4 WiFi LED matrix. Every loadFrame() call is counted and,
+// while capture is enabled, appended to a frame history that tests can read.
+// Each LED's on-time is integrated against micros(), like a slow light
+// sensor in front of the matrix, so brightness modulation can be measured.
+#pragma once
+
+#include <vector>
+#include "ArduinoGraphics.h"
+
+struct HostFrame {
+    uint32_t words[3];
+    unsigned long timeMs;              // millis() when the frame was loaded
+
+    bool operator==(const HostFrame& other) const {
+        return words[0] == other.words[0] && words[1] == other.words[1] && words[2] == other.words[2];
+    }
+};
+
+class ArduinoLEDMatrix : public ArduinoGraphics {
+private:
+    bool started;
+    bool capture;
+    unsigned long loads;
+    HostFrame last;
+    std::vector<HostFrame> history;
+    unsigned long integratedUs;        // micros() up to which onUs is counted
+    uint64_t onUs[96];
+
+    // Credit the frame on display with the time since the last integration
+    void integrate() {
+        unsigned long now = micros();
+        unsigned long elapsed = now - integratedUs;
+        integratedUs = now;
+        if ((long)elapsed < 0) return;     // The test moved the clock back
+        for (int led = 0; led < 96; led++) {
+            if (last.words[led / 32] & (1UL << (31 - led % 32))) onUs[led] += elapsed;
+        }
+    }
+
+public:
+    ArduinoLEDMatrix() : ArduinoGraphics(12, 8), started(false), capture(true), loads(0), integratedUs(micros()) {
+        last.words[0] = 0;
+        last.words[1] = 0;
+        last.words[2] = 0;
+        last.timeMs = 0;
+        for (int led = 0; led < 96; led++) onUs[led] = 0;
+    }
+
+    bool begin() { started = true; return true; }
+
+    void loadFrame(const uint32_t buffer[3]) {
+        integrate();
+        last.words[0] = buffer[0];
+        last.words[1] = buffer[1];
+        last.words[2] = buffer[2];
+        last.timeMs = millis();
+        loads++;
+        if (capture) history.push_back(last);
+    }
+
+    //--- Host-only inspection ---
+    bool isStarted() const { return started; }
+    unsigned long loadCount() const { return loads; }
+    const HostFrame& lastFrame() const { return last; }
+    const std::vector<HostFrame>& frames() const { return history; }
+    bool pixel(int x, int y) const {
+        int bit = y * 12 + x;
+        return (last.words[bit / 32] & (1UL << (31 - (bit % 32)))) != 0;
+    }
+    void setCapture(bool enabled) { capture = enabled; }
+    void resetCapture() { history.clear(); loads = 0; }
+
+    // Microseconds LED (y * 12 + x) has been lit since the last resetOnTime()
+    unsigned long onTime(int led) {
+        integrate();
+        return (unsigned long)onUs[led];
+    }
+    void resetOnTime() {
+        integratedUs = micros();
+        for (int led = 0; led < 96; led++) onUs[led] = 0;
+    }
+};
@@ -0,0 +1,74 @@
+// FspTimer.h (host shim)
+// Stand-in for the Renesas core's general-purpose timer. A started periodic
+// timer is driven by the simulated clock: moving the clock forward runs its
+// callback once per period, with micros() set to the moment it fires.
+#pragma once
+
+#include "Arduino.h"
+
+enum timer_mode_t {
+    TIMER_MODE_PERIODIC,
+    TIMER_MODE_ONE_SHOT,
+    TIMER_MODE_PWM
+};
+
+struct timer_callback_args_t {
+    void const* p_context;
+};
+
+typedef void (*GPTimerCbk_f)(timer_callback_args_t*);
+
+class FspTimer {
+private:
+    GPTimerCbk_f callback;
+    void* context;
+    unsigned long periodUs;
+    unsigned long dueUs;               // micros() of the next callback
+    bool running;
+    FspTimer* nextRunning;             // Started timers, in start order
+
+    static FspTimer* firstRunning;
+
+public:
+    FspTimer() : callback(nullptr), context(nullptr), periodUs(0), dueUs(0), running(false), nextRunning(nullptr) {}
+    ~FspTimer() { end(); }
+
+    FspTimer(const FspTimer&) = delete;
+    FspTimer& operator=(const FspTimer&) = delete;
+
+    static int8_t get_available_timer(uint8_t& type, bool force = false) {
+        (void)force;
+        type = 0;
+        return 0;
+    }
+
+    bool begin(timer_mode_t mode, uint8_t type, uint8_t channel, float freqHz, float dutyPercent,
+               GPTimerCbk_f cbk = nullptr, void* ctx = nullptr) {
+        (void)type; (void)channel; (void)dutyPercent;
+        if (mode != TIMER_MODE_PERIODIC || freqHz <= 0.0f) return false;
+        periodUs = (unsigned long)(1000000.0f / freqHz + 0.5f);
+        if (periodUs == 0) periodUs = 1;
+        callback = cbk;
+        context = ctx;
+        return true;
+    }
+
+    bool setup_overflow_irq(uint8_t priority = 12, void (*isr)() = nullptr) {
+        (void)priority; (void)isr;
+        return true;
+    }
+
+    bool open() { return periodUs != 0; }
+    bool start();
+    bool stop();
+    bool close() { return stop(); }
+    void end() { stop(); }
+
+    //--- Host-only ---
+    bool isRunning() const { return running; }
+    unsigned long getPeriodUs() const { return periodUs; }
+
+    // Called by the simulated clock (HostArduino.cpp)
+    static void runUntil(unsigned long untilUs);   // Fire every callback due on the way, in time order
+    static void restartAll(unsigned long nowUs);   // Clock moved back: next periods count from now
+};
@@ -0,0 +1,111 @@
+// HostArduino.cpp
+// Simulated clock, timers and font objects for the host shim
+#include "Arduino.h"
+#include "ArduinoGraphics.h"
+#include "FspTimer.h"
+
+static unsigned long hostMicros = 0;
+
+// Moving forward runs the timer callbacks due on the way, each at its own time
+static void moveClock(unsigned long us) {
+    if ((long)(us - hostMicros) < 0) {
+        hostMicros = us;
+        FspTimer::restartAll(us);
+        return;
+    }
+    FspTimer::runUntil(us);
+    hostMicros = us;
+}
+
+unsigned long millis() {
+    return hostMicros / 1000UL;
+}
+
+unsigned long micros() {
+    return hostMicros;
+}
+
+void delay(unsigned long ms) {
+    moveClock(hostMicros + ms * 1000UL);
+}
+
+void delayMicroseconds(unsigned int us) {
+    moveClock(hostMicros + us);
+}
+
+namespace host {
+
+void setMicros(unsigned long us) {
+    moveClock(us);
+}
+
+void setMillis(unsigned long ms) {
+    moveClock(ms * 1000UL);
+}
+
+void advanceMicros(unsigned long us) {
+    moveClock(hostMicros + us);
+}
+
+void advanceMillis(unsigned long ms) {
+    moveClock(hostMicros + ms * 1000UL);
+}
+
+}  // namespace host
+
+//------------------------------------------------------------------------------
+// FspTimer
+//------------------------------------------------------------------------------
+
+FspTimer* FspTimer::firstRunning = nullptr;
+
+bool FspTimer::start() {
+    if (periodUs == 0) return false;
+    dueUs = hostMicros + periodUs;
+    if (!running) {
+        running = true;
+        nextRunning = nullptr;
+        FspTimer** tail = &firstRunning;
+        while (*tail) tail = &(*tail)->nextRunning;
+        *tail = this;
+    }
+    return true;
+}
+
+bool FspTimer::stop() {
+    if (!running) return true;
+    running = false;
+    for (FspTimer** link = &firstRunning; *link; link = &(*link)->nextRunning) {
+        if (*link == this) {
+            *link = nextRunning;
+            break;
+        }
+    }
+    return true;
+}
+
+void FspTimer::runUntil(unsigned long untilUs) {
+    for (;;) {
+        FspTimer* next = nullptr;
+        for (FspTimer* t = firstRunning; t; t = t->nextRunning) {
+            if ((long)(untilUs - t->dueUs) < 0) continue;
+            if (next == nullptr || (long)(t->dueUs - next->dueUs) < 0) next = t;
+        }
+        if (next == nullptr) return;
+        hostMicros = next->dueUs;
+        next->dueUs += next->periodUs;
+        if (next->callback) {
+            timer_callback_args_t args = {next->context};
+            next->callback(&args);
+        }
+    }
+}
+
+void FspTimer::restartAll(unsigned long nowUs) {
+    for (FspTimer* t = firstRunning; t; t = t->nextRunning) {
+        t->dueUs = nowUs + t->periodUs;
+    }
+}
+
+const Font Font_4x6 = {4, 6, nullptr};
+const Font Font_5x7 = {5, 7, nullptr};
@@ -0,0 +1,61 @@
+// HostTest.h
+// Tiny self-registering test harness for the host build (no dependencies)
+#pragma once
+
+#include <stdio.h>
+#include "Arduino.h"
+#include "Arduino_LED_Matrix.h"
+
+namespace hosttest {
+
+typedef void (*TestFn)();
+
+struct TestCase {
+    const char* name;
+    TestFn fn;
+    TestCase* next;
+};
+
+TestCase*& registry();
+int& failures();
+
+struct Registrar {
+    TestCase entry;
+    Registrar(const char* name, TestFn fn) {
+        entry.name = name;
+        entry.fn = fn;
+        entry.next = registry();
+        registry() = &entry;
+    }
+};
+
+}  // namespace hosttest
+
+#define TEST(name) \
+    static void name(); \
+    static hosttest::Registrar name##_registrar(#name, name); \
+    static void name()
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        printf("  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        hosttest::failures()++; \
+    } \
+} while (0)
+
+#define CHECK_EQ(a, b) do { \
+    long long _a = (long long)(a); \
+    long long _b = (long long)(b); \
+    if (_a != _b) { \
+        printf("  %s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+        hosttest::failures()++; \
+    } \
+} while (0)
+
+// Compare the last frame pushed to a matrix against three expected words
+#define CHECK_FRAME(matrix, w0, w1, w2) do { \
+    const HostFrame& _f = (matrix).lastFrame(); \
+    CHECK_EQ(_f.words[0], (uint32_t)(w0)); \
+    CHECK_EQ(_f.words[1], (uint32_t)(w1)); \
+    CHECK_EQ(_f.words[2], (uint32_t)(w2)); \
+} while (0)
@@ -0,0 +1,64 @@
+// test_alloc.cpp
+// Starting and switching animations must not touch the heap
+#include <new>
+#include "HostTest.h"
+#include "TinyScreen.h"
+#include "idle.h"
+#include "go.h"
+
+static unsigned long heapAllocations = 0;
+
+void* operator new(size_t size) {
+    heapAllocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    heapAllocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+TEST(repeatedPlayDoesNotAllocate) {
+    TinyScreen screen;
+    screen.begin();
+    screen.getMatrix().setCapture(false);
+    int layer = screen.addLayer();
+    Animation idleAnim = idle;
+    Animation goAnim = go;
+
+    unsigned long before = heapAllocations;
+    for (int i = 0; i < 1000; i++) {
+        // Threshold sketches switch animations as sensors cross zones
+        screen.play((i & 1) ? idleAnim : goAnim, LOOP);
+        screen.play(idle, ONCE, 2, 3);
+        screen.playOnLayer(layer, go, BOOMERANG);
+        screen.setSpeed(1.5f);
+        host::advanceMillis(37);
+        screen.update();
+        screen.stopLayer(layer);
+    }
+    CHECK_EQ(heapAllocations - before, 0);
+}
+
+TEST(timingsComeFromFrameTable) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+
+    CHECK_EQ(screen.getCurrentSpeed(), idle[0][3]);
+    host::advanceMillis(idle[0][3]);
+    screen.update();
+    CHECK_EQ(screen.getCurrentSpeed(), idle[1][3]);
+
+    screen.setSpeed(2.0f);
+    CHECK_EQ(screen.getCurrentSpeed(), idle[1][3] / 2);
+}
@@ -0,0 +1,127 @@
+// test_canvas.cpp
+// Canvas and Hybrid Mode rendering against the simulated matrix
+#include "HostTest.h"
+#include "TinyScreen.h"
+#include "idle.h"
+
+TEST(endDrawPushesCanvas) {
+    TinyScreen screen;
+    screen.begin();
+
+    screen.beginDraw();
+    screen.clear();
+    screen.point(0, 0);
+    screen.point(11, 7);
+    screen.endDraw();
+
+    CHECK_EQ(screen.getMatrix().loadCount(), 1);
+    CHECK_FRAME(screen.getMatrix(), 0x80000000, 0, 0x00000001);
+}
+
+TEST(everyPixelMapsToItsLed) {
+    TinyScreen screen;
+    screen.begin();
+
+    for (int index = 0; index < 96; index++) {
+        screen.beginDraw();
+        screen.clear();
+        screen.point(index % 12, index / 12);
+        screen.endDraw();
+
+        uint32_t expected[3] = {0, 0, 0};
+        expected[index / 32] = 1UL << (31 - (index % 32));
+        CHECK_FRAME(screen.getMatrix(), expected[0], expected[1], expected[2]);
+    }
+}
+
+TEST(overlayKeepsRowsThatStraddleWords) {
+    // Rows 2 and 5 are split across frame words
+    static const uint32_t stripes[][4] = {
+        {0x000000FF, 0xF00000FF, 0xF0000000, 100}
+    };
+    TinyScreen screen;
+    screen.begin();
+    screen.play(stripes, LOOP);
+
+    screen.beginOverlay();
+    screen.endOverlay();
+    CHECK_FRAME(screen.getMatrix(), stripes[0][0], stripes[0][1], stripes[0][2]);
+
+    screen.beginOverlay();
+    screen.stroke(OFF);
+    screen.point(0, 2);
+    screen.point(7, 5);
+    screen.endOverlay();
+    CHECK_FRAME(screen.getMatrix(), 0x0000007F, 0xF00000FF, 0xE0000000);
+}
+
+TEST(filledRectCoversArea) {
+    TinyScreen screen;
+    screen.begin();
+
+    screen.beginDraw();
+    screen.clear();
+    screen.fill(ON);
+    screen.rect(2, 1, 3, 2);
+    screen.endDraw();
+
+    for (int y = 0; y < 8; y++) {
+        for (int x = 0; x < 12; x++) {
+            bool inside = x >= 2 && x < 5 && y >= 1 && y < 3;
+            CHECK_EQ(screen.getMatrix().pixel(x, y), inside);
+        }
+    }
+}
+
+TEST(rotationAndInvert) {
+    TinyScreen screen;
+    screen.begin();
+
+    screen.setRotation(180);
+    screen.beginDraw();
+    screen.clear();
+    screen.point(0, 0);
+    screen.endDraw();
+    CHECK(screen.getMatrix().pixel(11, 7));
+    CHECK(!screen.getMatrix().pixel(0, 0));
+
+    screen.setRotation(0);
+    screen.setInvert(true);
+    screen.beginDraw();
+    screen.clear();
+    screen.endDraw();
+    CHECK_FRAME(screen.getMatrix(), 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF);
+}
+
+TEST(overlayDrawsOverAnimation) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+
+    screen.beginOverlay();
+    screen.point(0, 0);
+    screen.endOverlay();
+
+    CHECK_FRAME(screen.getMatrix(), idle[0][0] | 0x80000000, idle[0][1], idle[0][2]);
+}
+
+TEST(scrollTextAdvancesWithTime) {
+    TinyScreen screen;
+    screen.begin();
+    screen.setScrollSpeed(50);
+    screen.resetScroll();
+
+    screen.beginDraw();
+    screen.clear();
+    screen.scrollText("HI", 1);
+    screen.endDraw();
+    CHECK_EQ(screen.getScrollOffset(), 0);
+
+    host::advanceMillis(50);
+    screen.beginDraw();
+    screen.clear();
+    screen.scrollText("HI", 1);
+    screen.endDraw();
+    CHECK_EQ(screen.getScrollOffset(), 1);
+    CHECK(screen.getMatrix().pixel(11, 1));
+}
@@ -0,0 +1,105 @@
+// test_compose.cpp
+// Layer blend modes, masks and z-order
+#include "HostTest.h"
+#include "TinyScreen.h"
+
+static const uint32_t base[][4] = {
+    {0xF0F0F0F0, 0x0000FFFF, 0x00000000, 100}
+};
+
+static const uint32_t top[][4] = {
+    {0xFF00FF00, 0x00FF00FF, 0x00000000, 100}
+};
+
+// Top row fully lit
+static const uint32_t topRow[][4] = {
+    {0xFFF00000, 0x00000000, 0x00000000, 100}
+};
+
+static void playPair(TinyScreen& screen, BlendMode mode) {
+    screen.begin();
+    screen.play(base, LOOP);
+    int layer = screen.addLayer();
+    screen.playOnLayer(layer, top, LOOP);
+    screen.setBlendModeOnLayer(layer, mode);
+    screen.update();
+}
+
+TEST(orIsDefault) {
+    TinyScreen screen;
+    playPair(screen, BLEND_OR);
+    CHECK_EQ(screen.getBlendModeOnLayer(1), BLEND_OR);
+    CHECK_FRAME(screen.getMatrix(), 0xFFF0FFF0, 0x00FFFFFF, 0);
+}
+
+TEST(andKeepsOverlap) {
+    TinyScreen screen;
+    playPair(screen, BLEND_AND);
+    CHECK_FRAME(screen.getMatrix(), 0xF000F000, 0x000000FF, 0);
+}
+
+TEST(xorTogglesPixels) {
+    TinyScreen screen;
+    playPair(screen, BLEND_XOR);
+    CHECK_FRAME(screen.getMatrix(), 0x0FF00FF0, 0x00FFFF00, 0);
+}
+
+TEST(subtractCutsOut) {
+    TinyScreen screen;
+    playPair(screen, BLEND_SUBTRACT);
+    CHECK_FRAME(screen.getMatrix(), 0x00F000F0, 0x0000FF00, 0);
+}
+
+TEST(replaceWithoutMaskCoversWholeLayer) {
+    TinyScreen screen;
+    playPair(screen, BLEND_REPLACE);
+    CHECK_FRAME(screen.getMatrix(), top[0][0], top[0][1], top[0][2]);
+}
+
+TEST(replaceMaskFollowsOffset) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(base, LOOP);
+    int layer = screen.addLayer();
+    screen.playOnLayer(layer, topRow, LOOP);
+    screen.setBlendModeOnLayer(layer, BLEND_REPLACE);
+    // Shifted down 7 rows, only the bottom row is replaced
+    screen.setPositionOnLayer(layer, 0, 7);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), base[0][0], base[0][1], 0x00000FFF);
+}
+
+TEST(replaceWithExplicitMask) {
+    static const uint32_t leftHalf[3] = {0xFC0FC0FC, 0x0FC0FC0F, 0xC0FC0FC0};
+    TinyScreen screen;
+    playPair(screen, BLEND_REPLACE);
+    screen.setMaskOnLayer(1, leftHalf);
+    screen.update();
+    uint32_t expected[3];
+    for (int w = 0; w < 3; w++) {
+        expected[w] = (base[0][w] & ~leftHalf[w]) | (top[0][w] & leftHalf[w]);
+    }
+    CHECK_FRAME(screen.getMatrix(), expected[0], expected[1], expected[2]);
+}
+
+TEST(zOrderChangesResult) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(base, LOOP);
+    screen.setBlendModeOnLayer(0, BLEND_REPLACE);
+    int layer = screen.addLayer();
+    screen.playOnLayer(layer, top, LOOP);
+    screen.update();
+    // Layer 1 drawn last: OR over the replaced base
+    CHECK_FRAME(screen.getMatrix(), 0xFFF0FFF0, 0x00FFFFFF, 0);
+
+    // Raise layer 0 above layer 1: its replace now wins
+    screen.setZOrderOnLayer(0, 1);
+    CHECK_EQ(screen.getZOrderOnLayer(0), 1);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), base[0][0], base[0][1], base[0][2]);
+
+    screen.setZOrderOnLayer(0, 0);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), 0xFFF0FFF0, 0x00FFFFFF, 0);
+}
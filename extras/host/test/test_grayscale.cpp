@@ -0,0 +1,293 @@
+// test_grayscale.cpp
+// Bit-plane modulation: each LED's measured on-time matches its level
+#include "HostTest.h"
+#include "TinyScreen.h"
+
+// Left half of the top row
+static const uint32_t leftHalf[][4] = {
+    {0xFC000000, 0, 0, 100}
+};
+
+// Columns 3-8 of the top row
+static const uint32_t middle[][4] = {
+    {0x1F800000, 0, 0, 100}
+};
+
+// The timer starts with setGrayscale(), at t = 0 here
+static void startGray(TinyScreenGray& screen, int bits) {
+    host::setMicros(0);
+    screen.begin();
+    CHECK(screen.setGrayscale(bits));
+    CHECK_EQ(screen.getGrayscale(), bits);
+}
+
+// Run whole modulation cycles from the next cycle start and report each
+// LED's on-time in ticks per cycle, which is the level it was shown at
+static void measureLevels(TinyScreenGray& screen, int cycles, int levels[96]) {
+    unsigned long cycleUs = (unsigned long)screen.getMaxLevel() * GRAY_TICK_US;
+    unsigned long now = micros();
+    unsigned long cycleStart = GRAY_TICK_US;   // The first tick opens the first cycle
+    // A cycle starting right now has already swapped in the image before this
+    while ((long)(cycleStart - now) <= 0) cycleStart += cycleUs;
+
+    host::setMicros(cycleStart);
+    screen.getMatrix().resetOnTime();
+    host::advanceMicros(cycles * cycleUs);
+    for (int led = 0; led < 96; led++) {
+        levels[led] = (int)(screen.getMatrix().onTime(led) / ((unsigned long)cycles * GRAY_TICK_US));
+    }
+}
+
+TEST(canvasLevelsAtTwoBits) {
+    TinyScreenGray screen;
+    startGray(screen, 2);
+    CHECK_EQ(screen.getMaxLevel(), 3);
+
+    screen.beginDraw();
+    screen.clear();
+    for (int level = 0; level <= 3; level++) {
+        screen.stroke(level * 85, level * 85, level * 85);
+        screen.point(level, 0);
+    }
+    screen.stroke(ON);
+    screen.line(0, 2, 11, 2);
+    screen.endDraw();
+
+    int levels[96];
+    measureLevels(screen, 4, levels);
+    for (int level = 0; level <= 3; level++) {
+        CHECK_EQ(levels[level], level);
+    }
+    CHECK_EQ(levels[24], 3);
+    CHECK_EQ(levels[35], 3);
+    CHECK_EQ(levels[12], 0);
+}
+
+TEST(deeperModesAreRefused) {
+    TinyScreenGray screen;
+    startGray(screen, 2);
+
+    // 3 and 4 bits would refresh at 15 and 7 Hz; the screen stays at 2 bits
+    CHECK(!screen.setGrayscale(3));
+    CHECK(!screen.setGrayscale(4));
+    CHECK_EQ(screen.getGrayscale(), 2);
+    CHECK_EQ(screen.getMaxLevel(), 3);
+
+    // One plane load per tick: the interrupt does 3 small copies per 28.8 ms cycle
+    screen.getMatrix().resetCapture();
+    host::advanceMicros(3UL * GRAY_TICK_US);
+    CHECK_EQ(screen.getMatrix().loadCount(), 3);
+
+    TinyScreenGray fresh;
+    fresh.begin();
+    CHECK(!fresh.setGrayscale(4));
+    CHECK_EQ(fresh.getGrayscale(), 0);
+}
+
+TEST(dimColorsStayVisible) {
+    TinyScreenGray screen;
+    startGray(screen, 2);
+    screen.beginDraw();
+    screen.clear();
+    screen.stroke(10, 10, 10);             // Rounds to 0, kept at the lowest level
+    screen.fill(170, 170, 170);
+    screen.rect(0, 0, 4, 4);
+    screen.endDraw();
+
+    int levels[96];
+    measureLevels(screen, 2, levels);
+    CHECK_EQ(levels[0], 1);                // Outline
+    CHECK_EQ(levels[13], 2);               // Inside
+}
+
+TEST(layerBrightnessTopmostWins) {
+    TinyScreenGray screen;
+    startGray(screen, 2);
+    screen.play(leftHalf, LOOP);
+    int layer = screen.addLayer();
+    screen.playOnLayer(layer, middle, LOOP);
+    screen.setBrightnessOnLayer(0, 85);
+    screen.setBrightnessOnLayer(layer, 170);
+    CHECK_EQ(screen.getBrightnessOnLayer(layer), 170);
+    screen.update();
+
+    int levels[96];
+    measureLevels(screen, 3, levels);
+    CHECK_EQ(levels[0], 1);
+    CHECK_EQ(levels[4], 2);                // Both layers; the upper one sets the level
+    CHECK_EQ(levels[8], 2);
+    CHECK_EQ(levels[9], 0);
+
+    // Putting the dim layer on top takes the overlap
+    screen.setZOrderOnLayer(0, 1);
+    screen.update();
+    measureLevels(screen, 3, levels);
+    CHECK_EQ(levels[4], 1);
+    CHECK_EQ(levels[8], 2);
+
+    // Blend modes still decide what is lit
+    screen.setBlendModeOnLayer(0, BLEND_SUBTRACT);
+    screen.update();
+    measureLevels(screen, 3, levels);
+    CHECK_EQ(levels[4], 0);
+    CHECK_EQ(levels[7], 2);
+
+    // A layer at brightness 0 is hidden
+    screen.setBlendModeOnLayer(0, BLEND_OR);
+    screen.setBrightnessOnLayer(layer, 0);
+    screen.update();
+    measureLevels(screen, 3, levels);
+    CHECK_EQ(levels[0], 1);
+    CHECK_EQ(levels[8], 0);
+}
+
+TEST(globalBrightnessScalesLevels) {
+    TinyScreenGray screen;
+    startGray(screen, 2);
+    screen.beginDraw();
+    screen.clear();
+    for (int level = 1; level <= 3; level++) {
+        screen.stroke(level * 85, 0, 0);
+        screen.point(level, 0);
+    }
+    screen.endDraw();
+
+    // Takes effect without another update() or endDraw()
+    screen.setBrightness(128);
+    CHECK_EQ(screen.getBrightness(), 128);
+    int levels[96];
+    measureLevels(screen, 3, levels);
+    CHECK_EQ(levels[1], 1);
+    CHECK_EQ(levels[2], 1);
+    CHECK_EQ(levels[3], 2);
+
+    screen.setBrightness(0);
+    measureLevels(screen, 3, levels);
+    CHECK_EQ(levels[3], 0);
+
+    screen.setBrightness(300);
+    CHECK_EQ(screen.getBrightness(), 255);
+    measureLevels(screen, 3, levels);
+    CHECK_EQ(levels[1], 1);
+    CHECK_EQ(levels[3], 3);
+}
+
+TEST(invertAndRotationApplyPerPlane) {
+    TinyScreenGray screen;
+    startGray(screen, 2);
+    screen.setInvert(true);
+    screen.beginDraw();
+    screen.clear();
+    screen.stroke(85, 85, 85);
+    screen.point(0, 0);
+    screen.endDraw();
+
+    int levels[96];
+    measureLevels(screen, 2, levels);
+    CHECK_EQ(levels[0], 2);                // 3 - 1
+    CHECK_EQ(levels[1], 3);
+
+    screen.setInvert(false);
+    screen.setRotation(180);
+    screen.beginDraw();
+    screen.endDraw();
+    measureLevels(screen, 2, levels);
+    CHECK_EQ(levels[0], 0);
+    CHECK_EQ(levels[95], 1);
+}
+
+TEST(overlayKeepsLayerLevels) {
+    TinyScreenGray screen;
+    startGray(screen, 2);
+    screen.play(leftHalf, LOOP);
+    screen.setBrightnessOnLayer(0, 85);
+
+    screen.beginOverlay();
+    screen.point(11, 7);                   // Overlays draw at full level
+    screen.endOverlay();
+
+    int levels[96];
+    measureLevels(screen, 2, levels);
+    CHECK_EQ(levels[0], 1);
+    CHECK_EQ(levels[95], 3);
+}
+
+TEST(onOffPathsShowFullLevel) {
+    TinyScreenGray screen;
+    startGray(screen, 2);
+    screen.led(5, 0, true);
+
+    int levels[96];
+    measureLevels(screen, 2, levels);
+    CHECK_EQ(levels[5], 3);
+
+    const uint32_t corner[3] = {0x80000000, 0, 0};
+    screen.displayFrame(corner);
+    measureLevels(screen, 2, levels);
+    CHECK_EQ(levels[0], 3);
+    CHECK_EQ(levels[5], 0);
+}
+
+TEST(backToMonochrome) {
+    TinyScreenGray screen;
+    startGray(screen, 2);
+    screen.beginDraw();
+    screen.clear();
+    screen.stroke(85, 85, 85);
+    screen.point(2, 0);
+    screen.endDraw();
+    host::advanceMicros(10UL * GRAY_TICK_US);
+
+    CHECK(screen.setGrayscale(0));
+    CHECK_EQ(screen.getGrayscale(), 0);
+    CHECK_EQ(screen.getMaxLevel(), 1);
+    CHECK_FRAME(screen.getMatrix(), 0x20000000, 0, 0);   // Still lit, now steadily
+
+    // The timer is stopped, so nothing else is loaded
+    screen.getMatrix().resetCapture();
+    host::advanceMillis(100);
+    CHECK_EQ(screen.getMatrix().loadCount(), 0);
+
+    // Drawing is on/off again
+    screen.beginDraw();
+    screen.stroke(85, 85, 85);
+    screen.point(3, 0);
+    screen.endDraw();
+    CHECK_FRAME(screen.getMatrix(), 0x30000000, 0, 0);
+}
+
+TEST(plainScreenHasNoGrayscale) {
+    CHECK(sizeof(TinyScreen) + sizeof(GrayscaleState) <= sizeof(TinyScreenGray));
+    TinyScreen screen;
+    screen.begin();
+    CHECK(!screen.hasGrayscale());
+    CHECK(!screen.setGrayscale(2));
+    CHECK_EQ(screen.getGrayscale(), 0);
+    CHECK(screen.setGrayscale(0));
+
+    // Shades still draw on/off
+    screen.beginDraw();
+    screen.clear();
+    screen.stroke(85, 85, 85);
+    screen.point(0, 0);
+    screen.endDraw();
+    CHECK_FRAME(screen.getMatrix(), 0x80000000, 0, 0);
+}
+
+// A grayscale screen that goes away takes its timer interrupt with it
+// (run under AddressSanitizer, a leftover callback is a use after scope)
+TEST(destroyedScreenStopsItsTimer) {
+    {
+        TinyScreenGray screen;
+        startGray(screen, 2);
+        host::advanceMicros(5UL * GRAY_TICK_US);
+    }
+    host::advanceMicros(10UL * GRAY_TICK_US);
+
+    TinyScreenGray again;              // The timer is free for the next screen
+    startGray(again, 2);
+    again.led(0, true);
+    int levels[96];
+    measureLevels(again, 2, levels);
+    CHECK_EQ(levels[0], 3);
+}
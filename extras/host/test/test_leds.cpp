@@ -0,0 +1,326 @@
+// test_leds.cpp
+// Simple LED control and blink timing against the simulated matrix
+#include "HostTest.h"
+#include "TinyScreen.h"
+
+TEST(ledWriteAutoShows) {
+    TinyScreen screen;
+    screen.begin();
+
+    screen.led(41, true);
+    CHECK_EQ(screen.getMatrix().loadCount(), 1);
+    CHECK(screen.getMatrix().pixel(5, 3));
+    CHECK(screen.getLed(5, 3));
+
+    screen.setAutoShow(false);
+    screen.led(0, 0, true);
+    CHECK_EQ(screen.getMatrix().loadCount(), 1);
+    screen.show();
+    CHECK_EQ(screen.getMatrix().loadCount(), 2);
+    CHECK(screen.getMatrix().pixel(0, 0));
+}
+
+TEST(blinkTogglesAtRate) {
+    TinyScreen screen;
+    screen.begin();
+
+    screen.blink(3, 2, 200);
+    CHECK(screen.getMatrix().pixel(3, 2));
+
+    host::setMillis(199);
+    screen.updateBlinks();
+    CHECK(screen.getLed(3, 2));
+
+    host::setMillis(200);
+    screen.updateBlinks();
+    CHECK(!screen.getLed(3, 2));
+    CHECK(!screen.getMatrix().pixel(3, 2));
+
+    host::setMillis(400);
+    screen.updateBlinks();
+    CHECK(screen.getLed(3, 2));
+
+    screen.noBlink(3, 2);
+    host::setMillis(600);
+    screen.updateBlinks();
+    CHECK(!screen.getLed(3, 2));
+}
+
+TEST(directWriteCancelsBlink) {
+    TinyScreen screen;
+    screen.begin();
+
+    screen.blink(7, 100);
+    screen.led(7, true);
+    host::setMillis(500);
+    screen.updateBlinks();
+    CHECK(screen.getLed(7));
+}
+
+TEST(nextDeadlineIncludesBlinksAndScroll) {
+    TinyScreen screen;
+    screen.begin();
+    CHECK_EQ(screen.nextDeadline(), NO_DEADLINE_MS);
+
+    screen.blink(3, 2, 200);
+    screen.blink(5, 1, 150);
+    CHECK_EQ(screen.nextDeadline(), 150);
+
+    host::setMillis(150);
+    screen.updateBlinks();
+    CHECK_EQ(screen.nextDeadline(), 200);
+
+    screen.noBlink();
+    CHECK_EQ(screen.nextDeadline(), 150 + NO_DEADLINE_MS);
+
+    screen.setScrollSpeed(80);
+    screen.beginDraw();
+    screen.scrollText("HI", 1);
+    screen.endDraw();
+    CHECK_EQ(screen.nextDeadline(), 230);
+
+    screen.resetScroll();
+    CHECK_EQ(screen.nextDeadline(), 150 + NO_DEADLINE_MS);
+}
+
+// Reference: the per-LED scan the scheduler replaced
+TEST(blinkSchedulerMatchesPerLedScan) {
+    TinyScreenT<1, 96> screen;
+    screen.begin();
+    screen.setAutoShow(false);
+
+    unsigned long rate[96] = {0};
+    unsigned long last[96] = {0};
+    bool state[96] = {false};
+    for (int i = 0; i < 96; i += 5) {
+        rate[i] = 37 + (i * 13) % 200;
+        screen.blink(i, rate[i]);
+        state[i] = true;
+    }
+
+    int mismatches = 0;
+    for (unsigned long t = 1; t <= 2000; t += 7) {
+        host::setMillis(t);
+        screen.updateBlinks();
+        for (int i = 0; i < 96; i++) {
+            if (rate[i] != 0 && t - last[i] >= rate[i]) {
+                last[i] = t;
+                state[i] = !state[i];
+            }
+            if (screen.getLed(i) != state[i]) mismatches++;
+        }
+        // Cancel and re-add some blinkers part way through
+        if (t == 505) {
+            screen.noBlink(10);
+            rate[10] = 0;
+            state[10] = false;
+            screen.blink(11, 90);
+            rate[11] = 90;
+            last[11] = t;
+            state[11] = true;
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST(blinkSlotsAreBounded) {
+    TinyScreenT<1, 2> screen;
+    screen.begin();
+    CHECK_EQ(screen.getBlinkCapacity(), 2);
+
+    CHECK(screen.blink(0, 100));
+    CHECK(screen.blink(1, 100));
+    CHECK(!screen.blink(2, 100));
+    CHECK(!screen.getLed(2));
+
+    // Re-blinking an LED reuses its slot; a direct write frees it
+    CHECK(screen.blink(1, 50));
+    screen.led(0, false);
+    CHECK(screen.blink(2, 100));
+}
+
+// Left half of rows 0-1 (x 0-5)
+static const uint32_t leftBlock[3] = {0xFC0FC000, 0x00000000, 0x00000000};
+// Right half of rows 0-1 (x 6-11)
+static const uint32_t rightBlock[3] = {0x03F03F00, 0x00000000, 0x00000000};
+
+TEST(blinkMaskTogglesGroupTogether) {
+    TinyScreen screen;
+    screen.begin();
+
+    CHECK(screen.blinkMask(leftBlock, 200));
+    CHECK_FRAME(screen.getMatrix(), leftBlock[0], 0, 0);
+    CHECK(screen.getLed(5, 1));
+    CHECK_EQ(screen.nextDeadline(), 200);
+
+    host::setMillis(200);
+    screen.updateBlinks();
+    CHECK_FRAME(screen.getMatrix(), 0, 0, 0);
+
+    // Late service keeps the group on its 200 ms grid (on at 400, off at 600)
+    host::setMillis(650);
+    screen.updateBlinks();
+    CHECK(!screen.getLed(0, 0));
+    CHECK_EQ(screen.nextDeadline(), 800);
+
+    // Static LEDs outside the group are untouched
+    screen.led(0, 7, true);
+    host::setMillis(800);
+    screen.updateBlinks();
+    CHECK(screen.getLed(0, 0));
+    CHECK(screen.getLed(0, 7));
+}
+
+TEST(blinkMaskJoinsGroupOfSameRate) {
+    TinyScreen screen;
+    screen.begin();
+
+    screen.blinkMask(leftBlock, 200);
+    host::setMillis(100);
+    screen.blinkMask(rightBlock, 200);
+    // Joined the running group, so both halves share one phase
+    host::setMillis(200);
+    screen.updateBlinks();
+    CHECK_FRAME(screen.getMatrix(), 0, 0, 0);
+    host::setMillis(400);
+    screen.updateBlinks();
+    CHECK_FRAME(screen.getMatrix(), leftBlock[0] | rightBlock[0], 0, 0);
+}
+
+TEST(phaseLockedGroupsShareTheClock) {
+    TinyScreen screen;
+    screen.begin();
+
+    host::setMillis(130);
+    screen.blinkMask(leftBlock, 100, true);
+    host::setMillis(370);
+    screen.blinkMask(rightBlock, 200, true);
+    // 100 ms group: periods 0,2,4.. lit; 200 ms group: period 1 (200-399) dark
+    CHECK(!screen.getLed(0, 0));
+    CHECK(!screen.getLed(6, 0));
+
+    host::setMillis(400);
+    screen.updateBlinks();
+    CHECK(screen.getLed(0, 0));
+    CHECK(screen.getLed(6, 0));
+}
+
+TEST(ledWritesLeaveBlinkGroup) {
+    TinyScreen screen;
+    screen.begin();
+
+    screen.blinkMask(leftBlock, 200);
+    screen.led(1, 0, false);
+    screen.blink(2, 0, 50);
+    host::setMillis(200);
+    screen.updateBlinks();
+    CHECK(!screen.getLed(1, 0));
+    CHECK(!screen.getLed(0, 0));
+    CHECK(!screen.getLed(2, 0));   // Own per-LED timer
+
+    host::setMillis(400);
+    screen.updateBlinks();
+    CHECK(screen.getLed(0, 0));
+    CHECK(!screen.getLed(1, 0));
+
+    // noBlink() freezes group LEDs in their current state
+    screen.noBlink();
+    host::setMillis(600);
+    screen.updateBlinks();
+    CHECK(screen.getLed(0, 0));
+
+    screen.noBlinkMask(leftBlock);
+    CHECK(!screen.getLed(0, 0));
+}
+
+// Many per-LED blinkers at mixed due times; a mask removal must catch every
+// one of them, wherever the heap holds it
+TEST(noBlinkMaskRemovesEveryMaskedBlinker) {
+    uint32_t seed = 12345;
+    for (int trial = 0; trial < 200; trial++) {
+        TinyScreenT<1, 96> screen;
+        host::setMillis(0);
+        screen.begin();
+        screen.setAutoShow(false);
+
+        uint32_t mask[3] = {0, 0, 0};
+        for (int led = 0; led < 96; led++) {
+            seed = seed * 1103515245 + 12345;
+            if ((seed >> 16) % 3 == 0) continue;
+            screen.blink(led, 20 + (seed >> 8) % 300);
+            if ((seed >> 24) & 1) mask[led / 32] |= 1UL << (31 - led % 32);
+        }
+        // Stagger the due times before removing
+        host::setMillis(1 + trial % 50);
+        screen.updateBlinks();
+
+        if (trial & 1) screen.noBlinkMask(mask);
+        else screen.blinkMask(mask, 100000);   // Taken over by a slow group (on until 100 s)
+
+        bool expected = (trial & 1) == 0;
+        int wrong = 0;
+        for (unsigned long t = 60; t <= 1000; t += 10) {
+            host::setMillis(t);
+            screen.updateBlinks();
+            for (int led = 0; led < 96; led++) {
+                if (!(mask[led / 32] & (1UL << (31 - led % 32)))) continue;
+                if (screen.getLed(led) != expected) wrong++;
+            }
+        }
+        CHECK_EQ(wrong, 0);
+    }
+}
+
+// examples/01_Basics/BlinkFrame: the 64 outer LEDs blink through ledBlink()
+TEST(ledBlinkCoversEveryLed) {
+    ledBegin();
+    CHECK_EQ(getLedMatrix().getBlinkCapacity(), 96);
+    getLedMatrix().setAutoShow(false);
+
+    int accepted = 0;
+    for (int x = 0; x < 12; x++) {
+        for (int y = 0; y < 8; y++) {
+            if (x >= 2 && x <= 9 && y >= 2 && y <= 5) ledWrite(x, y, HIGH);
+            else if (getLedMatrix().blink(x, y, 100 + (x * 8 + y) * 7)) accepted++;
+        }
+    }
+    CHECK_EQ(accepted, 64);
+
+    // Cancel the left columns one by one after the heap has been reshuffled;
+    // each write must find its own blinker and leave the rest running
+    host::setMillis(1000);
+    ledUpdate();
+    for (int y = 0; y < 8; y++) {
+        ledWrite(0, y, HIGH);
+        ledWrite(1, y, LOW);
+    }
+    int toggled = 0;
+    for (unsigned long t = 1010; t <= 3000; t += 10) {
+        host::setMillis(t);
+        ledUpdate();
+        for (int y = 0; y < 8; y++) {
+            CHECK(ledRead(0, y));
+            CHECK(!ledRead(1, y));
+        }
+        if (ledRead(11, 0) != ledRead(11, 1)) toggled++;
+    }
+    CHECK(toggled > 0);
+    ledNoBlink();
+    ledClear();
+}
+
+TEST(plainScreenBlinkerIsCompact) {
+    CHECK_EQ(sizeof(BlinkTimer), 8u);
+    TinyScreen screen;
+    screen.begin();
+    CHECK_EQ(screen.getBlinkCapacity(), MAX_BLINKS);
+
+    // Longer intervals than a BlinkTimer holds are capped
+    CHECK(screen.blink(0, 100000));
+    host::setMillis(65534);
+    screen.updateBlinks();
+    CHECK(screen.getLed(0));
+    host::setMillis(65535);
+    screen.updateBlinks();
+    CHECK(!screen.getLed(0));
+}
@@ -0,0 +1,41 @@
+// test_main.cpp
+// Runs every TEST() linked into the executable
+#include "HostTest.h"
+
+namespace hosttest {
+
+TestCase*& registry() {
+    static TestCase* head = nullptr;
+    return head;
+}
+
+int& failures() {
+    static int count = 0;
+    return count;
+}
+
+}  // namespace hosttest
+
+int main() {
+    // Registration prepends, so reverse to run in file order
+    hosttest::TestCase* ordered = nullptr;
+    hosttest::TestCase* tc = hosttest::registry();
+    while (tc) {
+        hosttest::TestCase* next = tc->next;
+        tc->next = ordered;
+        ordered = tc;
+        tc = next;
+    }
+
+    int run = 0;
+    for (tc = ordered; tc; tc = tc->next) {
+        int before = hosttest::failures();
+        host::setMillis(0);
+        tc->fn();
+        printf("%s %s\n", hosttest::failures() == before ? "[PASS]" : "[FAIL]", tc->name);
+        run++;
+    }
+
+    printf("%d tests, %d failed checks\n", run, hosttest::failures());
+    return hosttest::failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+// test_packed.cpp
+// Packed (compressed) animations play exactly like their frame tables
+#include <vector>
+#include "HostTest.h"
+#include "TinyScreen.h"
+#include "AnimationPacker.h"
+#include "idle.h"
+
+// 40 frames: a dot stepping across the matrix under a steady top bar
+static uint32_t walk[40][4];
+
+static void buildWalk() {
+    for (int i = 0; i < 40; i++) {
+        int led = 12 + (i * 7) % 84;
+        walk[i][0] = 0xFFF00000;
+        walk[i][1] = 0;
+        walk[i][2] = 0;
+        walk[i][led / 32] |= 1UL << (31 - led % 32);
+        walk[i][3] = (i % 5 == 0) ? 120 : 60;
+    }
+}
+
+// Run a plain and a packed layer side by side; count frames that differ
+template<size_t N>
+static int comparePlayback(const uint32_t (&table)[N][4], int keyframeInterval,
+                           PlayMode mode, int startFrame, int endFrame) {
+    std::vector<uint8_t> bytes = tfpack::pack(tfpack::framesOf(table), keyframeInterval);
+
+    AnimationLayer plain;
+    AnimationLayer packed;
+    host::setMillis(0);
+    plain.start(table, mode, startFrame, endFrame);
+    packed.start(Animation(bytes.data(), bytes.size()), mode, startFrame, endFrame);
+
+    int mismatches = 0;
+    uint32_t a[3];
+    uint32_t b[3];
+    for (unsigned long t = 0; t < 6000; t += 10) {
+        host::setMillis(t);
+        plain.updateFrame();
+        packed.updateFrame();
+        plain.getFrame(a);
+        packed.getFrame(b);
+        if (a[0] != b[0] || a[1] != b[1] || a[2] != b[2]) mismatches++;
+        if (plain.getCurrentFrameNum() != packed.getCurrentFrameNum()) mismatches++;
+        if (plain.getCurrentSpeed() != packed.getCurrentSpeed()) mismatches++;
+    }
+    return mismatches;
+}
+
+TEST(packedMatchesFrameTable) {
+    buildWalk();
+    CHECK_EQ(comparePlayback(idle, 16, LOOP, 0, 0), 0);
+    CHECK_EQ(comparePlayback(walk, 8, LOOP, 0, 0), 0);
+    CHECK_EQ(comparePlayback(walk, 8, BOOMERANG, 0, 0), 0);
+    CHECK_EQ(comparePlayback(walk, 8, ONCE, 0, 0), 0);
+    // Backward range, and ranges starting between keyframes
+    CHECK_EQ(comparePlayback(walk, 8, LOOP, 35, 3), 0);
+    CHECK_EQ(comparePlayback(walk, 8, BOOMERANG, 11, 29), 0);
+    CHECK_EQ(comparePlayback(walk, 1, LOOP, 0, 0), 0);
+    CHECK_EQ(comparePlayback(walk, 255, BOOMERANG, 0, 0), 0);
+}
+
+TEST(packedPlaysOnScreen) {
+    std::vector<uint8_t> bytes = tfpack::pack(tfpack::framesOf(idle));
+    TinyScreen screen;
+    screen.begin();
+    screen.play(Animation(bytes.data(), bytes.size()), LOOP);
+    CHECK_EQ(screen.getTotalFrames(), 4);
+
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[0][0], idle[0][1], idle[0][2]);
+    host::setMillis(300);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[1][0], idle[1][1], idle[1][2]);
+
+    screen.setPosition(1, 1);
+    screen.update();
+    CHECK(screen.getMatrix().lastFrame().words[0] != idle[1][0]);
+}
+
+TEST(packedIsSmallerAndStoresUniformTimingOnce) {
+    buildWalk();
+    std::vector<uint8_t> bytes = tfpack::pack(tfpack::framesOf(walk), 16);
+    CHECK(bytes.size() < sizeof(walk) / 2);
+    CHECK_EQ(bytes[1] & PACKED_UNIFORM_TIMING, 0);
+
+    static uint32_t steady[30][4];
+    for (int i = 0; i < 30; i++) {
+        steady[i][0] = (i & 1) ? 0x80000000 : 0;
+        steady[i][3] = 100;
+    }
+    std::vector<uint8_t> uniform = tfpack::pack(tfpack::framesOf(steady), 16);
+    CHECK_EQ(uniform[1], PACKED_UNIFORM_TIMING);
+    CHECK_EQ(comparePlayback(steady, 16, LOOP, 0, 0), 0);
+}
+
+TEST(invalidPackedDataIsIgnored) {
+    static const uint8_t garbage[] = {7, 0, 4, 0, 16, 0};
+    static const uint8_t tooShort[] = {PACKED_FORMAT, 0};
+    Animation a = garbage;
+    Animation b = tooShort;
+    CHECK_EQ(a.getFrameCount(), 0);
+    CHECK_EQ(b.getFrameCount(), 0);
+
+    TinyScreen screen;
+    screen.begin();
+    screen.play(garbage, LOOP);
+    CHECK(screen.isIdle());
+}
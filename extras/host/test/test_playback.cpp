@@ -0,0 +1,674 @@
+// test_playback.cpp
+// Animation Mode playback against the simulated matrix
+#include "HostTest.h"
+#include "TinyScreen.h"
+#include "idle.h"
+
+// One lit pixel in the top-left corner
+static const uint32_t dot[][4] = {
+    {0x80000000, 0x00000000, 0x00000000, 100}
+};
+
+TEST(loopFollowsAuthoredTimings) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[0][0], idle[0][1], idle[0][2]);
+
+    host::setMillis(299);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 1);
+
+    host::setMillis(300);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 2);
+    CHECK_FRAME(screen.getMatrix(), idle[1][0], idle[1][1], idle[1][2]);
+
+    host::setMillis(450);
+    screen.update();
+    host::setMillis(600);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+
+    host::setMillis(750);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 1);
+    CHECK(screen.isPlaying());
+}
+
+TEST(onceCompletesAfterLastFrame) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, ONCE);
+
+    unsigned long t = 0;
+    for (int i = 0; i < 4; i++) {
+        t += idle[screen.getCurrentFrame() - 1][3];
+        host::setMillis(t);
+        screen.update();
+    }
+    CHECK(screen.isComplete());
+}
+
+TEST(boomerangReversesAtEnds) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, BOOMERANG);
+
+    int expected[] = {2, 3, 4, 3, 2, 1, 2};
+    unsigned long t = 0;
+    for (int i = 0; i < 7; i++) {
+        t += idle[screen.getCurrentFrame() - 1][3];
+        host::setMillis(t);
+        screen.update();
+        CHECK_EQ(screen.getCurrentFrame(), expected[i]);
+    }
+}
+
+TEST(layersAreCombined) {
+    TinyScreen screen;
+    screen.begin();
+    int top = screen.addLayer();
+    screen.playOnLayer(0, idle, LOOP);
+    screen.playOnLayer(top, dot, LOOP);
+
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[0][0] | 0x80000000, idle[0][1], idle[0][2]);
+}
+
+TEST(layerCapacityIsATemplateParameter) {
+    TinyScreenT<1> small;
+    CHECK_EQ(small.getLayerCapacity(), 1);
+    CHECK_EQ(small.addLayer(), -1);
+    CHECK(sizeof(TinyScreenT<1>) < sizeof(TinyScreen));
+
+    // One dot per layer across the top rows
+    static uint32_t dots[12][1][4];
+    TinyScreenT<12> big;
+    big.begin();
+    for (int i = 0; i < 12; i++) {
+        dots[i][0][0] = 1UL << (31 - i);
+        dots[i][0][1] = 0;
+        dots[i][0][2] = 0;
+        dots[i][0][3] = 100;
+        int layer = (i == 0) ? 0 : big.addLayer();
+        CHECK_EQ(layer, i);
+        big.playOnLayer(layer, Animation(dots[i]), LOOP);
+    }
+    CHECK_EQ(big.addLayer(), -1);
+    big.update();
+    CHECK_FRAME(big.getMatrix(), 0xFFF00000, 0, 0);
+}
+
+TEST(stoppedLayersLeaveComposite) {
+    TinyScreen screen;
+    screen.begin();
+    int top = screen.addLayer();
+    screen.playOnLayer(0, dot, LOOP);
+    screen.playOnLayer(top, idle, LOOP);
+
+    screen.pauseLayer(0);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[0][0] | 0x80000000, idle[0][1], idle[0][2]);
+
+    screen.stopLayer(0);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[0][0], idle[0][1], idle[0][2]);
+}
+
+TEST(positionOffsetClips) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(dot, LOOP);
+
+    screen.setPosition(1, 0);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), 0x40000000, 0, 0);
+
+    screen.setPosition(0, 1);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), 0x00080000, 0, 0);
+
+    screen.setPosition(-1, 0);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), 0, 0, 0);
+}
+
+TEST(offsetMatchesPerPixelClipping) {
+    static const uint32_t noise[][4] = {
+        {0x9A3C5E71, 0x2F8D04B6, 0xC7E1935A, 100}
+    };
+    AnimationLayer layer;
+    layer.start(noise, LOOP, 0, 0);
+
+    int mismatches = 0;
+    for (int oy = -9; oy <= 9; oy++) {
+        for (int ox = -13; ox <= 13; ox++) {
+            layer.setOffset(ox, oy);
+            uint32_t frame[3];
+            layer.getFrame(frame);
+
+            uint32_t expected[3] = {0, 0, 0};
+            for (int row = 0; row < 8; row++) {
+                for (int col = 0; col < 12; col++) {
+                    int srcCol = col - ox;
+                    int srcRow = row - oy;
+                    if (srcCol < 0 || srcCol >= 12 || srcRow < 0 || srcRow >= 8) continue;
+                    int srcBit = srcRow * 12 + srcCol;
+                    if (noise[0][srcBit / 32] & (1UL << (31 - srcBit % 32))) {
+                        int dstBit = row * 12 + col;
+                        expected[dstBit / 32] |= 1UL << (31 - dstBit % 32);
+                    }
+                }
+            }
+            if (frame[0] != expected[0] || frame[1] != expected[1] || frame[2] != expected[2]) mismatches++;
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST(positionedFrameCacheFollowsChanges) {
+    static const uint32_t other[][4] = {
+        {0x00000000, 0x00000000, 0x00000001, 100}
+    };
+    AnimationLayer layer;
+    uint32_t frame[3];
+
+    layer.start(dot, LOOP, 0, 0);
+    layer.setOffset(2, 0);
+    layer.getFrame(frame);
+    CHECK_EQ(frame[0], 0x20000000);
+    layer.getFrame(frame);
+    CHECK_EQ(frame[0], 0x20000000);
+
+    layer.setOffset(0, 1);
+    layer.getFrame(frame);
+    CHECK_EQ(frame[0], 0x00080000);
+
+    // New animation at the same frame index and offset
+    layer.start(other, LOOP, 0, 0);
+    layer.setOffset(0, 1);
+    layer.getFrame(frame);
+    CHECK_EQ(frame[0], 0);
+    CHECK_EQ(frame[2], 0);
+
+    // Frame advance
+    layer.start(idle, LOOP, 0, 0);
+    layer.setOffset(-1, 0);
+    uint32_t first[3];
+    layer.getFrame(first);
+    host::advanceMillis(idle[0][3]);
+    layer.updateFrame();
+    layer.getFrame(frame);
+    CHECK(frame[1] != first[1]);
+}
+
+TEST(unchangedFramesAreNotPushed) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+    const ArduinoLEDMatrix& matrix = static_cast<const TinyScreen&>(screen).getMatrix();   // Read-only: keeps the cache
+
+    for (int i = 0; i < 50; i++) {
+        host::setMillis(i);
+        screen.update();
+    }
+    CHECK_EQ(matrix.loadCount(), 1);
+    CHECK_EQ(screen.getSkippedPushes(), 0);   // Idle updates return before composing anything
+
+    // A recomposed frame that matches the matrix is not pushed again
+    screen.setPosition(0, 0);
+    screen.update();
+    CHECK_EQ(matrix.loadCount(), 1);
+    CHECK_EQ(screen.getSkippedPushes(), 1);
+
+    host::setMillis(300);
+    screen.update();
+    CHECK_EQ(matrix.loadCount(), 2);
+
+    // displayFrame() always reaches the matrix
+    screen.displayFrame(matrix.lastFrame().words);
+    CHECK_EQ(matrix.loadCount(), 3);
+}
+
+TEST(matrixAccessInvalidatesPushedFrame) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+    screen.update();
+    CHECK_EQ(screen.getMatrix().loadCount(), 1);
+
+    // Drawn over directly; the same composite must still go back out
+    const uint32_t blank[3] = {0, 0, 0};
+    screen.getMatrix().loadFrame(blank);
+    screen.setPosition(0, 0);
+    screen.update();
+    CHECK_EQ(screen.getMatrix().loadCount(), 3);
+    CHECK_EQ(screen.getSkippedPushes(), 0);
+    CHECK_FRAME(screen.getMatrix(), idle[0][0], idle[0][1], idle[0][2]);
+}
+
+TEST(nextDeadlineFollowsFrameTimer) {
+    TinyScreen screen;
+    screen.begin();
+    // No layers yet: nothing for update() to draw
+    CHECK(!screen.needsUpdate());
+    CHECK_EQ(screen.nextDeadline(), NO_DEADLINE_MS);
+
+    screen.play(idle, LOOP);
+    // New animation not shown yet
+    CHECK_EQ(screen.nextDeadline(), 0);
+    screen.update();
+    CHECK_EQ(screen.nextDeadline(), idle[0][3]);
+
+    host::setMillis(100);
+    CHECK(!screen.needsUpdate());
+    CHECK_EQ(screen.nextDeadline(), idle[0][3]);
+
+    host::setMillis(idle[0][3]);
+    CHECK(screen.needsUpdate());
+    screen.update();
+    CHECK_EQ(screen.nextDeadline(), idle[0][3] + idle[1][3]);
+
+    // Paused layers have no deadline; settings changes need one update
+    screen.pause();
+    CHECK(screen.needsUpdate());
+    screen.update();
+    CHECK_EQ(screen.nextDeadline(), idle[0][3] + NO_DEADLINE_MS);
+
+    screen.setPosition(1, 0);
+    CHECK(screen.needsUpdate());
+    CHECK_EQ(screen.nextDeadline(), idle[0][3]);
+}
+
+TEST(needsUpdateAgreesWithNextDeadline) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+    screen.update();
+
+    // Stopping the only layer still needs one update() to clear it
+    screen.stop();
+    CHECK(screen.needsUpdate());
+    CHECK_EQ(screen.nextDeadline(), 0);
+    screen.update();
+    CHECK(!screen.needsUpdate());
+    CHECK_EQ(screen.nextDeadline(), NO_DEADLINE_MS);
+
+    // Canvas drawing with no layers leaves nothing for update() to do
+    screen.beginDraw();
+    screen.set(0, 0, 1);
+    screen.endDraw();
+    CHECK(!screen.needsUpdate());
+    CHECK_EQ(screen.nextDeadline(), NO_DEADLINE_MS);
+}
+
+TEST(sleepingUntilDeadlineMatchesPolling) {
+    TinyScreen polled;
+    TinyScreen slept;
+    polled.begin();
+    slept.begin();
+    polled.play(idle, BOOMERANG);
+    slept.play(idle, BOOMERANG);
+
+    int sleptUpdates = 0;
+    unsigned long wake = 0;
+    for (unsigned long t = 0; t <= 3000; t++) {
+        host::setMillis(t);
+        polled.update();
+        if ((long)(t - wake) >= 0) {
+            slept.update();
+            sleptUpdates++;
+            wake = slept.nextDeadline();
+        }
+        CHECK_EQ(slept.getCurrentFrame(), polled.getCurrentFrame());
+    }
+    CHECK_EQ(slept.getMatrix().loadCount(), polled.getMatrix().loadCount());
+    CHECK(sleptUpdates < 30);
+}
+
+TEST(completedOnceHoldsLastFrame) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, ONCE);
+    host::setMillis(5000);
+    for (int i = 0; i < 4; i++) {
+        host::advanceMillis(300);
+        screen.update();
+    }
+    CHECK(screen.isComplete());
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+    CHECK_FRAME(screen.getMatrix(), idle[3][0], idle[3][1], idle[3][2]);
+
+    // Backward range ends on its first frame
+    screen.play(idle, ONCE, 3, 1);
+    for (int i = 0; i < 4; i++) {
+        host::advanceMillis(300);
+        screen.update();
+    }
+    CHECK(screen.isComplete());
+    CHECK_EQ(screen.getCurrentFrame(), 1);
+    CHECK_FRAME(screen.getMatrix(), idle[0][0], idle[0][1], idle[0][2]);
+}
+
+// Frame (1-based) that idle should show t ms into LOOP playback
+static int idleFrameAt(unsigned long t) {
+    unsigned long inCycle = t % 750;
+    if (inCycle < 300) return 1;
+    return 2 + (int)((inCycle - 300) / 150);
+}
+
+TEST(dropTimingFollowsWallClock) {
+    TinyScreen screen;
+    screen.begin();
+    screen.setTimingMode(TIMING_DROP);
+    screen.play(idle, LOOP);
+
+    // Irregular loop with stalls (e.g. a blocking sensor read)
+    unsigned long t = 0;
+    int mismatches = 0;
+    for (int i = 0; i < 200; i++) {
+        t += (i % 17 == 0) ? 1234 : 7 + (i * 31) % 90;
+        host::setMillis(t);
+        screen.update();
+        if (screen.getCurrentFrame() != idleFrameAt(t)) mismatches++;
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+// Frame (1-based) idle should show t ms into BOOMERANG playback (1 2 3 4 3 2)
+static int idleBoomerangFrameAt(unsigned long t) {
+    static const int order[] = {1, 2, 3, 4, 3, 2};
+    unsigned long inCycle = t % 1050;
+    if (inCycle < 300) return 1;
+    return order[1 + (inCycle - 300) / 150];
+}
+
+TEST(dropTimingKeepsPhaseAfterLongStall) {
+    TinyScreen looped;
+    TinyScreen bounced;
+    TinyScreen once;
+    looped.begin();
+    bounced.begin();
+    once.begin();
+    looped.setTimingMode(TIMING_DROP);
+    bounced.setTimingMode(TIMING_DROP);
+    once.setTimingMode(TIMING_DROP);
+    looped.play(idle, LOOP);
+    bounced.play(idle, BOOMERANG);
+    once.play(idle, ONCE);
+
+    // Hundreds of loops behind, well past any per-call frame budget
+    const unsigned long stalls[] = {100UL * 1050 + 400, 100UL * 1050 + 760, 5000UL * 1050 + 1000};
+    for (unsigned long t : stalls) {
+        host::setMillis(t);
+        looped.update();
+        bounced.update();
+        once.update();
+        CHECK_EQ(looped.getCurrentFrame(), idleFrameAt(t));
+        CHECK_EQ(bounced.getCurrentFrame(), idleBoomerangFrameAt(t));
+        CHECK(once.isComplete());
+        CHECK_EQ(once.getCurrentFrame(), 4);
+    }
+
+    // Still on the original schedule afterwards
+    for (unsigned long t = stalls[2]; t < stalls[2] + 2100; t += 50) {
+        host::setMillis(t);
+        looped.update();
+        bounced.update();
+        CHECK_EQ(looped.getCurrentFrame(), idleFrameAt(t));
+        CHECK_EQ(bounced.getCurrentFrame(), idleBoomerangFrameAt(t));
+    }
+}
+
+TEST(catchUpTimingShowsEveryFrame) {
+    TinyScreen screen;
+    screen.begin();
+    screen.setTimingMode(TIMING_CATCH_UP);
+    screen.play(idle, LOOP);
+
+    // Stall past three frame changes (300, 450, 600), then update quickly
+    host::setMillis(610);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 2);
+    host::setMillis(611);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 3);
+    host::setMillis(612);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+
+    // Back on the original schedule: next change at 750, not 612 + 150
+    host::setMillis(613);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+    host::setMillis(749);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+    host::setMillis(750);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 1);
+}
+
+TEST(relativeTimingDefaultLagsAfterStall) {
+    TinyScreen screen;
+    screen.begin();
+    CHECK_EQ(screen.getTimingMode(), TIMING_RELATIVE);
+    screen.play(idle, LOOP);
+
+    host::setMillis(1000);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 2);
+    host::setMillis(1149);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 2);
+}
+
+TEST(speedMultiplierMatchesFloatRounding) {
+    static const float multipliers[] = {0.1f, 0.25f, 0.5f, 0.75f, 1.0f, 1.5f, 2.0f, 3.0f, 7.3f, 150.0f};
+    AnimationLayer layer;
+    int mismatches = 0;
+    for (float m : multipliers) {
+        layer.start(idle, LOOP, 0, 0);
+        layer.setSpeed(m);
+        for (int f = 0; f < 4; f++) {
+            long expected = lround(idle[f][3] / m);
+            if (expected < 1) expected = 1;
+            if (layer.getCurrentSpeed() != expected) mismatches++;
+            host::advanceMillis(layer.getCurrentSpeed());
+            layer.updateFrame();
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+
+    // Reversing keeps the magnitude
+    layer.start(idle, LOOP, 0, 0);
+    layer.setSpeed(-2.0f);
+    CHECK_EQ(layer.getCurrentSpeed(), 150);
+    CHECK(layer.isPlayingBackwards());
+}
+
+// Compile-time descriptor of a constexpr copy of idle
+static constexpr uint32_t idleTable[][4] = {
+    {0x80280, 0x25542a88, 0x2802000, 300},
+    {0x802ff, 0xed56ffe8, 0x2802000, 150},
+    {0x4017f, 0xf6ab7ff4, 0x1401000, 150},
+    {0x802ff, 0xed56ffe8, 0x2802000, 150}
+};
+DESCRIBE_ANIMATION(idleInfo, idleTable);
+
+static_assert(idleInfo.timing.totalMs == 750, "total duration");
+static_assert(idleInfo.timing.minFrameMs == 150 && idleInfo.timing.maxFrameMs == 300, "min/max");
+static_assert(idleInfo.timing.narrowTiming, "all times fit 16 bits");
+static_assert(idleInfo.startMs[1] == 300 && idleInfo.startMs[3] == 600 && idleInfo.startMs[4] == 750, "prefix sums");
+
+static constexpr uint32_t untimed[][4] = { {0, 0, 0, 100}, {0, 0, 0, 0} };
+static constexpr uint32_t shortRows[][3] = { {0, 0, 0} };
+static constexpr uint32_t slow[][4] = { {0, 0, 0, 70000} };
+static_assert(!animationTimesValid(untimed), "zero frame time rejected");
+static_assert(!animationTimesValid(shortRows), "3-word rows rejected");
+static_assert(!describeAnimation(slow).timing.narrowTiming, "wide frame time flagged");
+
+TEST(descriptorPlaysLikeFrameTable) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idleInfo, LOOP);
+    CHECK_EQ(screen.getTotalFrames(), 4);
+    CHECK_EQ(screen.getTotalDuration(), 750ul);
+
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[0][0], idle[0][1], idle[0][2]);
+    host::setMillis(300);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[1][0], idle[1][1], idle[1][2]);
+    host::setMillis(450);
+    screen.update();
+    host::setMillis(600);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+}
+
+// Described inside a function: the layer keeps pointers into the descriptor
+static void playDescribedLocally(TinyScreen& screen) {
+    DESCRIBE_ANIMATION(localInfo, idleTable);
+    screen.play(localInfo, LOOP);
+}
+
+// Writes over the stack the function above used
+static volatile uint32_t stackScratch;
+static void clobberStack() {
+    volatile uint32_t junk[64];
+    for (int i = 0; i < 64; i++) junk[i] = 0xA5A5A5A5;
+    stackScratch = junk[63];
+}
+
+TEST(descriptorInsideFunctionOutlivesIt) {
+    TinyScreen screen;
+    screen.begin();
+    playDescribedLocally(screen);
+    clobberStack();
+    CHECK_EQ(screen.getTotalDuration(), 750ul);
+
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[0][0], idle[0][1], idle[0][2]);
+    host::setMillis(300);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[1][0], idle[1][1], idle[1][2]);
+    screen.seekToTime(600);
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+}
+
+TEST(totalDurationWithoutDescriptor) {
+    TinyScreen screen;
+    screen.begin();
+    CHECK_EQ(screen.getTotalDuration(), 0ul);
+    screen.play(idle, ONCE);
+    CHECK_EQ(screen.getTotalDuration(), 750ul);
+    screen.setSpeed(2.0f);
+    CHECK_EQ(screen.getTotalDuration(), 750ul);
+}
+
+TEST(seekToTimeFindsFrame) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+    static const unsigned long times[] = {0, 299, 300, 449, 450, 600, 749, 5000};
+    static const int frames[] = {1, 1, 2, 2, 3, 4, 4, 4};
+    for (int i = 0; i < 8; i++) {
+        screen.seekToTime(times[i]);
+        CHECK_EQ(screen.getCurrentFrame(), frames[i]);
+    }
+
+    screen.seekToFraction(0.0f);
+    CHECK_EQ(screen.getCurrentFrame(), 1);
+    screen.seekToFraction(0.5f);   // 375 ms
+    CHECK_EQ(screen.getCurrentFrame(), 2);
+    screen.seekToFraction(1.0f);
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+    screen.seekToFrame(3);
+    CHECK_EQ(screen.getCurrentFrame(), 3);
+    screen.seekToFrame(99);
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+}
+
+TEST(seekKeepsTimeIntoFrame) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+    screen.update();
+
+    host::setMillis(1000);
+    screen.seekToTime(350);        // 50 ms into frame 2 (150 ms long)
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idle[1][0], idle[1][1], idle[1][2]);
+    host::setMillis(1099);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 2);
+    host::setMillis(1100);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 3);
+}
+
+TEST(seekDescriptorMatchesLinearSearch) {
+    AnimationLayer plain;
+    AnimationLayer described;
+    static const int ranges[][2] = { {0, 0}, {2, 4}, {4, 1}, {3, 3} };
+    for (int r = 0; r < 4; r++) {
+        plain.start(idle, LOOP, ranges[r][0], ranges[r][1]);
+        described.start(idleInfo, LOOP, ranges[r][0], ranges[r][1]);
+        for (unsigned long t = 0; t < 800; t += 5) {
+            plain.seekToTime(t);
+            described.seekToTime(t);
+            CHECK_EQ(plain.getCurrentFrameNum(), described.getCurrentFrameNum());
+        }
+    }
+}
+
+TEST(seekBackwardRangeRunsFromEnd) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP, 4, 1);
+    screen.seekToTime(0);
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+    screen.seekToTime(150);
+    CHECK_EQ(screen.getCurrentFrame(), 3);
+    screen.seekToTime(300);
+    CHECK_EQ(screen.getCurrentFrame(), 2);
+    screen.seekToTime(749);
+    CHECK_EQ(screen.getCurrentFrame(), 1);
+}
+
+TEST(seekKeepsPauseAndRevivesCompleted) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+    screen.pause();
+    screen.seekToFrame(3);
+    screen.update();
+    CHECK(screen.isPaused());
+    CHECK_FRAME(screen.getMatrix(), idle[2][0], idle[2][1], idle[2][2]);
+
+    screen.play(dot, ONCE);
+    host::setMillis(100);
+    screen.update();
+    CHECK(screen.isComplete());
+    screen.seekToFrame(1);
+    CHECK(screen.isPlaying());
+
+    // Idle layers ignore seeks
+    screen.stop();
+    screen.seekToTime(10);
+    CHECK(screen.isIdle());
+}
+
+TEST(seekBoomerangTurnsAtFarEnd) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, BOOMERANG);
+    screen.seekToFrame(4);
+    host::setMillis(150);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 3);
+}
@@ -0,0 +1,198 @@
+// test_playlist.cpp
+// Queued animations take over inside update() with no gap between them
+#include <vector>
+#include "HostTest.h"
+#include "TinyScreen.h"
+#include "idle.h"
+
+// A plain TinyScreen has no queue slots
+using QueueScreen = TinyScreenT<MAX_LAYERS, MAX_BLINKS, 4>;
+
+// Three 100 ms frames, one lit LED each
+static const uint32_t bars[3][4] = {
+    {0x80000000, 0, 0, 100},
+    {0x40000000, 0, 0, 100},
+    {0x20000000, 0, 0, 100}
+};
+
+struct Shown {
+    const uint32_t* words;
+    unsigned long ms;
+};
+
+// idle ONCE, bars LOOP x2, idle 1..3 BOOMERANG x1, bars 3..1 ONCE
+static std::vector<Shown> expectedSequence() {
+    std::vector<Shown> shown;
+    for (int i = 0; i < 4; i++) shown.push_back({idle[i], idle[i][3]});
+    for (int loop = 0; loop < 2; loop++) {
+        for (int i = 0; i < 3; i++) shown.push_back({bars[i], 100});
+    }
+    static const int there[] = {0, 1, 2, 1};
+    for (int i : there) shown.push_back({idle[i], idle[i][3]});
+    for (int i = 2; i >= 0; i--) shown.push_back({bars[i], 100});
+    return shown;
+}
+
+static const uint32_t* expectedAt(const std::vector<Shown>& shown, unsigned long t) {
+    for (const Shown& s : shown) {
+        if (t < s.ms) return s.words;
+        t -= s.ms;
+    }
+    return shown.back().words;   // The last ONCE holds its final frame
+}
+
+static void queueSequence(QueueScreen& screen) {
+    host::setMillis(0);
+    CHECK(screen.queue(idle));
+    CHECK(screen.queue(bars, LOOP, 2));
+    CHECK(screen.queue(idle, BOOMERANG, 1, 1, 3));
+    CHECK(screen.queue(bars, ONCE, 1, 3, 1));
+}
+
+// Update every stepMs until 3000 ms; count frames that differ from the schedule
+static int playSequence(QueueScreen& screen, unsigned long stepMs) {
+    std::vector<Shown> shown = expectedSequence();
+    int mismatches = 0;
+    for (unsigned long t = 0; t < 3000; t += stepMs) {
+        host::setMillis(t);
+        screen.update();
+        const uint32_t* want = expectedAt(shown, t);
+        const uint32_t* got = screen.getMatrix().lastFrame().words;
+        if (got[0] != want[0] || got[1] != want[1] || got[2] != want[2]) mismatches++;
+    }
+    return mismatches;
+}
+
+TEST(queuedEntriesPlayBackToBack) {
+    QueueScreen screen;
+    screen.begin();
+    queueSequence(screen);
+    CHECK(screen.isPlaying());             // The first entry started right away
+    CHECK_EQ(screen.getQueueLength(), 3);
+
+    CHECK_EQ(playSequence(screen, 1), 0);
+    CHECK(screen.isComplete());
+    CHECK_EQ(screen.getQueueLength(), 0);
+}
+
+TEST(lateUpdatesLoseNoTimeBetweenEntries) {
+    // Anchored timing: every update shows the frame due at that moment,
+    // even when an entry changed over between two updates
+    QueueScreen screen;
+    screen.begin();
+    screen.setTimingMode(TIMING_DROP);
+    queueSequence(screen);
+    CHECK_EQ(playSequence(screen, 37), 0);
+}
+
+TEST(followingLayersPlayTheQueueOnTheTimeline) {
+    QueueScreen screen;
+    screen.begin();
+    screen.followTimeline();
+    queueSequence(screen);
+    CHECK_EQ(playSequence(screen, 1), 0);
+
+    QueueScreen late;
+    late.begin();
+    late.followTimeline();
+    queueSequence(late);
+    CHECK_EQ(playSequence(late, 41), 0);
+}
+
+static void runUntil(QueueScreen& screen, unsigned long& t, unsigned long end) {
+    for (; t <= end; t++) {
+        host::setMillis(t);
+        screen.update();
+    }
+}
+
+TEST(endlessLoopFinishesItsPassWhenMoreIsQueued) {
+    QueueScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+
+    unsigned long t = 0;
+    runUntil(screen, t, 1000);             // 250 ms into the second loop
+    CHECK(screen.queue(bars));
+    CHECK(screen.isPlaying());
+    runUntil(screen, t, 1499);
+    CHECK_FRAME(screen.getMatrix(), idle[3][0], idle[3][1], idle[3][2]);
+    runUntil(screen, t, 1500);
+    CHECK_FRAME(screen.getMatrix(), bars[0][0], bars[0][1], bars[0][2]);
+    runUntil(screen, t, 1800);
+    CHECK(screen.isComplete());
+}
+
+TEST(loopCountsOnALayer) {
+    AnimationLayer layer;
+    host::setMillis(0);
+    layer.start(idle, BOOMERANG, 0, 0);
+    layer.setLoopCount(2);                 // Out and back twice: 2 x 1050 ms
+    for (unsigned long t = 0; t < 2100; t++) {
+        host::setMillis(t);
+        layer.updateFrame();
+    }
+    CHECK(layer.isPlaying());
+    CHECK_EQ(layer.getLoopsDone(), 1UL);
+    host::setMillis(2100);
+    layer.updateFrame();
+    CHECK(layer.isComplete());
+    CHECK_EQ(layer.getCurrentFrameNum(), 1);
+}
+
+TEST(queueIsBoundedAndClearedByPlay) {
+    TinyScreenT<2, 1, 2> screen;
+    screen.begin();
+    CHECK_EQ(screen.getQueueCapacity(), 2);
+    screen.play(idle, LOOP);
+    CHECK(screen.queue(bars));
+    CHECK(screen.queue(idle));
+    CHECK(!screen.queue(bars));            // Full
+    CHECK(!screen.queueOnLayer(1, Animation()));
+    CHECK(!screen.queueOnLayer(3, bars));  // No such layer
+    CHECK_EQ(screen.getQueueLength(), 2);
+
+    screen.play(bars, LOOP);               // play() replaces the whole playlist
+    CHECK_EQ(screen.getQueueLength(), 0);
+    CHECK_EQ(screen.getQueueLengthOnLayer(1), 0);
+
+    int layer = screen.addLayer();
+    screen.playOnLayer(layer, idle, LOOP);
+    CHECK(screen.queueOnLayer(layer, bars));
+    CHECK_EQ(screen.getQueueLengthOnLayer(layer), 1);
+    screen.stopLayer(layer);
+    CHECK_EQ(screen.getQueueLengthOnLayer(layer), 0);
+}
+
+TEST(plainScreenHasNoQueue) {
+    CHECK(sizeof(TinyScreen) < sizeof(QueueScreen));
+    TinyScreen screen;
+    screen.begin();
+    CHECK_EQ(screen.getQueueCapacity(), 0);
+    CHECK(!screen.queue(idle));
+    CHECK_EQ(screen.getQueueLength(), 0);
+    CHECK(screen.isIdle());
+
+    // Completing with nothing to chain into is unaffected
+    screen.play(bars, ONCE);
+    for (unsigned long t = 0; t <= 300; t += 100) {
+        host::setMillis(t);
+        screen.update();
+    }
+    CHECK(screen.isComplete());
+    screen.clearQueue();
+}
+
+TEST(clearingTheQueueKeepsTheLoopGoing) {
+    QueueScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+    CHECK(screen.queue(bars));
+    screen.clearQueue();
+    CHECK_EQ(screen.getQueueLength(), 0);
+
+    unsigned long t = 0;
+    runUntil(screen, t, 2000);
+    CHECK(screen.isPlaying());             // Nothing queued, so the loop carries on
+    CHECK_EQ(screen.getCurrentFrame(), 3);
+}
@@ -0,0 +1,101 @@
+// test_pool.cpp
+// Pooled animations (shared frames + FrameStep lists) play like their frame tables
+#include "HostTest.h"
+#include "TinyScreen.h"
+#include "idle.h"
+
+// idle's three distinct frames, in the order they first appear
+static const uint32_t idlePool[][3] = {
+    { 0x80280, 0x25542a88, 0x2802000 },
+    { 0x802ff, 0xed56ffe8, 0x2802000 },
+    { 0x4017f, 0xf6ab7ff4, 0x1401000 }
+};
+static const FrameStep idleSteps[] = { {0, 300}, {1, 150}, {2, 150}, {1, 150} };
+static const FrameStep blinkSteps[] = { {2, 100}, {0, 100} };
+
+static const Animation idlePooled(idlePool, idleSteps);
+static const Animation blinkPooled(idlePool, blinkSteps);
+
+static int comparePlayback(PlayMode mode, int startFrame, int endFrame) {
+    AnimationLayer plain;
+    AnimationLayer pooled;
+    host::setMillis(0);
+    plain.start(idle, mode, startFrame, endFrame);
+    pooled.start(idlePooled, mode, startFrame, endFrame);
+
+    int mismatches = 0;
+    uint32_t a[3];
+    uint32_t b[3];
+    for (unsigned long t = 0; t < 3000; t += 10) {
+        host::setMillis(t);
+        plain.updateFrame();
+        pooled.updateFrame();
+        plain.getFrame(a);
+        pooled.getFrame(b);
+        if (a[0] != b[0] || a[1] != b[1] || a[2] != b[2]) mismatches++;
+        if (plain.getCurrentFrameNum() != pooled.getCurrentFrameNum()) mismatches++;
+        if (plain.getCurrentSpeed() != pooled.getCurrentSpeed()) mismatches++;
+    }
+    return mismatches;
+}
+
+TEST(pooledMatchesFrameTable) {
+    CHECK(idlePooled.isPooled());
+    CHECK_EQ(idlePooled.getFrameCount(), 4);
+    CHECK_EQ(comparePlayback(LOOP, 0, 0), 0);
+    CHECK_EQ(comparePlayback(BOOMERANG, 0, 0), 0);
+    CHECK_EQ(comparePlayback(ONCE, 0, 0), 0);
+    CHECK_EQ(comparePlayback(LOOP, 4, 2), 0);
+}
+
+// The frame sources share one union: two pointers, a count and a kind tag
+static constexpr Animation constPooled(idlePool, idleSteps);
+static_assert(sizeof(Animation) <= 3 * sizeof(void*), "Animation stays two pointers plus a tag");
+
+TEST(animationKindsKeepTheirOwnSource) {
+    CHECK(constPooled.isPooled());
+    CHECK(!constPooled.isPacked());
+    CHECK(constPooled.getFrames() == nullptr);
+    CHECK(constPooled.getStartTimes() == nullptr);
+    CHECK(constPooled.getPool() == idlePool);
+
+    Animation table = idle;
+    CHECK(!table.isPooled());
+    CHECK(table.getFrames() == idle);
+    CHECK(table.getSequence() == nullptr);
+    CHECK(table.getPacked() == nullptr);
+    CHECK_EQ(table.getFrameCount(), 4);
+
+    Animation empty;
+    CHECK(empty.getFrames() == nullptr);
+    CHECK_EQ(empty.getFrameCount(), 0);
+}
+
+TEST(layersShareOnePool) {
+    TinyScreen screen;
+    screen.begin();
+    screen.playOnLayer(0, idlePooled, LOOP);
+    int top = screen.addLayer();
+    screen.playOnLayer(top, blinkPooled, LOOP);
+    screen.setBlendModeOnLayer(top, BLEND_REPLACE);
+
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idlePool[2][0], idlePool[2][1], idlePool[2][2]);
+    host::setMillis(100);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), idlePool[0][0], idlePool[0][1], idlePool[0][2]);
+}
+
+TEST(invalidStepsAreIgnored) {
+    static const FrameStep outOfPool[] = { {0, 100}, {3, 100} };
+    static const FrameStep zeroTime[] = { {0, 100}, {1, 0} };
+    Animation a(idlePool, outOfPool);
+    Animation b(idlePool, zeroTime);
+    CHECK_EQ(a.getFrameCount(), 0);
+    CHECK_EQ(b.getFrameCount(), 0);
+
+    TinyScreen screen;
+    screen.begin();
+    screen.play(a, LOOP);
+    CHECK(screen.isIdle());
+}
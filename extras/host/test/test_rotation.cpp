@@ -0,0 +1,103 @@
+// test_rotation.cpp
+// Table-driven rotation matches the original per-pixel mapping
+#include "HostTest.h"
+#include "TinyScreen.h"
+
+// Reference: the original per-pixel source lookup (-1 = cropped)
+static void refSource(int rotation, int row, int col, int& srcRow, int& srcCol) {
+    switch (rotation) {
+        case 1: {
+            int rx = col - 2, ry = row + 2;
+            srcRow = (rx >= 0 && rx < 8 && ry >= 0 && ry < 12) ? (7 - rx) : -1;
+            srcCol = ry;
+            break;
+        }
+        case 2:
+            srcRow = 7 - row;
+            srcCol = 11 - col;
+            break;
+        case 3: {
+            int rx = col - 2, ry = row + 2;
+            srcRow = rx;
+            srcCol = (rx >= 0 && rx < 8 && ry >= 0 && ry < 12) ? (11 - ry) : -1;
+            break;
+        }
+        default:
+            srcRow = row;
+            srcCol = col;
+            break;
+    }
+}
+
+static bool refPixel(const bool src[8][12], int rotation, int x, int y) {
+    int srcRow, srcCol;
+    refSource(rotation, y, x, srcRow, srcCol);
+    if (srcRow < 0 || srcRow >= 8 || srcCol < 0 || srcCol >= 12) return false;
+    return src[srcRow][srcCol];
+}
+
+static uint32_t lcg(uint32_t& state) {
+    state = state * 1664525UL + 1013904223UL;
+    return state >> 8;
+}
+
+TEST(canvasRotationMatchesReference) {
+    TinyScreen screen;
+    screen.begin();
+    screen.getMatrix().setCapture(false);
+
+    uint32_t seed = 12345;
+    int mismatches = 0;
+    for (int trial = 0; trial < 200; trial++) {
+        bool src[8][12];
+        screen.beginDraw();
+        for (int y = 0; y < 8; y++) {
+            for (int x = 0; x < 12; x++) {
+                src[y][x] = (lcg(seed) & 1) != 0;
+                screen.set(x, y, src[y][x]);
+            }
+        }
+        for (int r = 0; r < 4; r++) {
+            screen.setRotation(r * 90);
+            screen.beginDraw();
+            screen.endDraw();
+            for (int y = 0; y < 8; y++)
+                for (int x = 0; x < 12; x++)
+                    if (screen.getMatrix().pixel(x, y) != refPixel(src, r, x, y)) mismatches++;
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST(animationsFollowRotation) {
+    // Top-left pixel and one pixel inside the 90° crop
+    static const uint32_t marks[][4] = {
+        {0x80000000 | (1UL << (31 - (1 * 12 + 3))), 0, 0, 100}
+    };
+    bool src[8][12] = {};
+    src[0][0] = true;
+    src[1][3] = true;
+
+    TinyScreen screen;
+    screen.begin();
+    screen.play(marks, LOOP);
+
+    for (int r = 0; r < 4; r++) {
+        screen.setRotation(r * 90);
+        screen.update();
+        int mismatches = 0;
+        for (int y = 0; y < 8; y++)
+            for (int x = 0; x < 12; x++)
+                if (screen.getMatrix().pixel(x, y) != refPixel(src, r, x, y)) mismatches++;
+        CHECK_EQ(mismatches, 0);
+    }
+
+    // Overlay rotates the animation and drawing together
+    screen.setRotation(180);
+    screen.beginOverlay();
+    screen.point(11, 7);
+    screen.endOverlay();
+    CHECK(screen.getMatrix().pixel(11, 7));
+    CHECK(screen.getMatrix().pixel(0, 0));
+    CHECK(screen.getMatrix().pixel(8, 6));
+}
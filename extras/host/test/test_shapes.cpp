@@ -0,0 +1,149 @@
+// test_shapes.cpp
+// Filled shapes match the original per-pixel rasterizers
+#include "HostTest.h"
+#include "TinyScreen.h"
+
+// Reference: the per-pixel algorithms the span fills replaced
+struct RefCanvas {
+    bool px[8][12];
+
+    void clear() { memset(px, 0, sizeof(px)); }
+    void point(int x, int y) { if (x >= 0 && x < 12 && y >= 0 && y < 8) px[y][x] = true; }
+
+    void circle(int cx, int cy, int r) {
+        if (r <= 0) { point(cx, cy); return; }
+        int x = r, y = 0, err = 1 - r;
+        while (x >= y) {
+            for (int i = cx - x; i <= cx + x; i++) { point(i, cy + y); point(i, cy - y); }
+            for (int i = cx - y; i <= cx + y; i++) { point(i, cy + x); point(i, cy - x); }
+            y++;
+            if (err < 0) err += 2 * y + 1;
+            else { x--; err += 2 * (y - x) + 1; }
+        }
+    }
+
+    void ellipse(int cx, int cy, int w, int h) {
+        int a = w / 2, b = h / 2;
+        if (a <= 0 || b <= 0) { point(cx, cy); return; }
+        int x = 0, y = b;
+        int d1 = (b * b) - (a * a * b) + (a * a / 4);
+        int dx = 2 * b * b * x, dy = 2 * a * a * y;
+        while (dx < dy) {
+            for (int i = cx - x; i <= cx + x; i++) { point(i, cy + y); point(i, cy - y); }
+            x++;
+            dx += 2 * b * b;
+            if (d1 < 0) d1 += dx + b * b;
+            else { y--; dy -= 2 * a * a; d1 += dx - dy + b * b; }
+        }
+        int d2 = b * b * (x * x + x) + a * a * (y - 1) * (y - 1) - a * a * b * b;
+        while (y >= 0) {
+            for (int i = cx - x; i <= cx + x; i++) { point(i, cy + y); point(i, cy - y); }
+            y--;
+            dy -= 2 * a * a;
+            if (d2 > 0) d2 += a * a - dy;
+            else { x++; dx += 2 * b * b; d2 += dx - dy + a * a; }
+        }
+    }
+
+    void rect(int x, int y, int w, int h) {
+        for (int row = y; row < y + h; row++)
+            for (int col = x; col < x + w; col++) point(col, row);
+    }
+};
+
+static bool matches(TinyScreen& screen, const RefCanvas& ref) {
+    for (int y = 0; y < 8; y++)
+        for (int x = 0; x < 12; x++)
+            if (screen.getMatrix().pixel(x, y) != ref.px[y][x]) return false;
+    return true;
+}
+
+static void beginFilled(TinyScreen& screen) {
+    screen.beginDraw();
+    screen.clear();
+    screen.noStroke();
+    screen.fill(ON);
+}
+
+TEST(filledCircleMatchesReference) {
+    TinyScreen screen;
+    screen.begin();
+    screen.getMatrix().setCapture(false);
+    RefCanvas ref;
+
+    int mismatches = 0;
+    for (int d = 0; d <= 20; d++) {
+        for (int cy = -3; cy <= 10; cy++) {
+            for (int cx = -3; cx <= 14; cx++) {
+                beginFilled(screen);
+                screen.circle(cx, cy, d);
+                screen.endDraw();
+                ref.clear();
+                ref.circle(cx, cy, d / 2);
+                if (!matches(screen, ref)) mismatches++;
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST(filledEllipseMatchesReference) {
+    TinyScreen screen;
+    screen.begin();
+    screen.getMatrix().setCapture(false);
+    RefCanvas ref;
+
+    int mismatches = 0;
+    for (int w = 0; w <= 16; w++) {
+        for (int h = 0; h <= 12; h++) {
+            for (int cy = -2; cy <= 9; cy += 3) {
+                for (int cx = -2; cx <= 13; cx += 3) {
+                    beginFilled(screen);
+                    screen.ellipse(cx, cy, w, h);
+                    screen.endDraw();
+                    ref.clear();
+                    ref.ellipse(cx, cy, w, h);
+                    if (!matches(screen, ref)) mismatches++;
+                }
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST(filledRectMatchesReference) {
+    TinyScreen screen;
+    screen.begin();
+    screen.getMatrix().setCapture(false);
+    RefCanvas ref;
+
+    int mismatches = 0;
+    for (int w = -1; w <= 14; w++) {
+        for (int h = -1; h <= 10; h++) {
+            for (int y = -3; y <= 8; y += 2) {
+                for (int x = -3; x <= 12; x += 2) {
+                    beginFilled(screen);
+                    screen.rect(x, y, w, h);
+                    screen.endDraw();
+                    ref.clear();
+                    ref.rect(x, y, w, h);
+                    if (!matches(screen, ref)) mismatches++;
+                }
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+TEST(fillOffClearsSpan) {
+    TinyScreen screen;
+    screen.begin();
+
+    screen.beginDraw();
+    screen.background(ON);
+    screen.noStroke();
+    screen.fill(OFF);
+    screen.rect(0, 0, 12, 1);
+    screen.endDraw();
+    CHECK_FRAME(screen.getMatrix(), 0x000FFFFF, 0xFFFFFFFF, 0xFFFFFFFF);
+}
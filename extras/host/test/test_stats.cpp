@@ -0,0 +1,92 @@
+// test_stats.cpp
+// Frame statistics (built with TINYSCREEN_STATS=1)
+#include "HostTest.h"
+#include "TinyScreen.h"
+#include "idle.h"
+
+TEST(updateRecordsEveryStage) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+
+    // Every update has a frame due (idle frames are 150-300 ms)
+    for (int i = 0; i < 10; i++) {
+        host::advanceMillis(300);
+        screen.update();
+    }
+
+    const TinyScreenStats& stats = screen.getStats();
+    CHECK_EQ(stats.layerAdvance.count, 10);
+    CHECK_EQ(stats.compositing.count, 10);
+    CHECK_EQ(stats.canvas.count, 0);
+    CHECK_EQ(stats.framesPushed + stats.framesSkipped, 10);
+    CHECK_EQ(stats.push.count, stats.framesPushed);
+}
+
+TEST(idleUpdateIsNotCountedAsSkipped) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+    screen.update();
+
+    screen.resetStats();
+    host::advanceMillis(10);
+    screen.update();
+
+    CHECK_EQ(screen.getStats().layerAdvance.count, 0);
+    CHECK_EQ(screen.getStats().framesSkipped, 0);   // No push was attempted
+}
+
+TEST(canvasAndOverlayAreTimed) {
+    TinyScreen screen;
+    screen.begin();
+    screen.play(idle, LOOP);
+
+    screen.beginDraw();
+    screen.point(1, 1);
+    screen.endDraw();
+
+    screen.beginOverlay();
+    screen.point(2, 2);
+    screen.endOverlay();
+
+    const TinyScreenStats& stats = screen.getStats();
+    CHECK_EQ(stats.canvas.count, 2);
+    CHECK_EQ(stats.layerAdvance.count, 1);
+    CHECK_EQ(stats.framesPushed, 2);
+}
+
+TEST(cleanShowCountsAsSkipped) {
+    TinyScreen screen;
+    screen.begin();
+    screen.setAutoShow(false);
+
+    screen.led(3, true);
+    screen.show();
+    screen.show();
+
+    CHECK_EQ(screen.getStats().framesPushed, 1);
+    CHECK_EQ(screen.getStats().framesSkipped, 1);
+
+    // Dirty but identical frame: elided at the matrix push
+    screen.led(3, true);
+    screen.show();
+    CHECK_EQ(screen.getStats().framesPushed, 1);
+    CHECK_EQ(screen.getStats().framesSkipped, 2);
+
+    screen.resetStats();
+    CHECK_EQ(screen.getStats().framesPushed, 0);
+}
+
+TEST(stageTimingTracksMinMaxAvg) {
+    StageTiming timing;
+    timing.reset();
+    timing.record(40);
+    timing.record(10);
+    timing.record(100);
+
+    CHECK_EQ(timing.minUs, 10);
+    CHECK_EQ(timing.maxUs, 100);
+    CHECK_EQ(timing.avgUs(), 50);
+    CHECK_EQ(timing.count, 3);
+}
@@ -0,0 +1,218 @@
+// test_timeline.cpp
+// Layers following a Timeline stay in lockstep with it
+#include "HostTest.h"
+#include "TinyScreen.h"
+#include "idle.h"
+
+// Frame number idle shows t ms into a loop (300, 150, 150, 150)
+static int idleFrameAt(unsigned long t) {
+    t %= 750;
+    return t < 300 ? 1 : t < 450 ? 2 : t < 600 ? 3 : 4;
+}
+
+// A following layer and a free-running one updated every ms must agree
+static int compareWithFreeRunning(PlayMode mode, int startFrame, int endFrame,
+                                  int speedMs = 0, float multiplier = 0.0f) {
+    Timeline master;
+    AnimationLayer own;
+    AnimationLayer locked;
+    host::setMillis(0);
+    locked.setTimeline(&master);
+    own.start(idle, mode, startFrame, endFrame);
+    locked.start(idle, mode, startFrame, endFrame);
+    if (speedMs != 0) {
+        own.setSpeed(speedMs);
+        locked.setSpeed(speedMs);
+    }
+    if (multiplier != 0.0f) {
+        own.setSpeed(multiplier);
+        locked.setSpeed(multiplier);
+    }
+
+    int mismatches = 0;
+    for (unsigned long t = 0; t < 4000; t++) {
+        host::setMillis(t);
+        own.updateFrame();
+        locked.updateFrame();
+        if (own.getCurrentFrameNum() != locked.getCurrentFrameNum()) mismatches++;
+        if (own.getState() != locked.getState()) mismatches++;
+    }
+    return mismatches;
+}
+
+TEST(followingMatchesFreeRunningSequence) {
+    CHECK_EQ(compareWithFreeRunning(LOOP, 0, 0), 0);
+    CHECK_EQ(compareWithFreeRunning(ONCE, 0, 0), 0);
+    CHECK_EQ(compareWithFreeRunning(BOOMERANG, 0, 0), 0);
+    CHECK_EQ(compareWithFreeRunning(LOOP, 4, 2), 0);
+    CHECK_EQ(compareWithFreeRunning(BOOMERANG, 4, 1), 0);
+    CHECK_EQ(compareWithFreeRunning(ONCE, 3, 1), 0);
+}
+
+TEST(followingKeepsLayerSpeed) {
+    CHECK_EQ(compareWithFreeRunning(LOOP, 0, 0, 60), 0);
+    CHECK_EQ(compareWithFreeRunning(BOOMERANG, 0, 0, 150), 0);
+    CHECK_EQ(compareWithFreeRunning(LOOP, 0, 0, -80), 0);
+    CHECK_EQ(compareWithFreeRunning(LOOP, 0, 0, 0, 1.5f), 0);
+    CHECK_EQ(compareWithFreeRunning(BOOMERANG, 4, 1, 0, 0.5f), 0);
+}
+
+TEST(speedChangeKeepsFrameWhileFollowing) {
+    TinyScreen screen;
+    screen.begin();
+    screen.followTimeline();
+    screen.play(idle, BOOMERANG);
+
+    host::setMillis(800);                // Frame 3 on the way back (750-900)
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 3);
+    screen.setSpeed(100);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 3);
+    host::setMillis(900);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 2);   // Still heading back
+    host::setMillis(1000);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 1);
+}
+
+TEST(followingLayersNeverDrift) {
+    TinyScreen screen;
+    screen.begin();
+    screen.followTimeline();
+    int top = screen.addLayer();
+    screen.followTimelineOnLayer(top);
+    screen.play(idle, LOOP);
+    screen.playOnLayer(top, idle, LOOP);
+    screen.setBlendModeOnLayer(top, BLEND_XOR);
+
+    // Ten minutes of a loop() that runs late by a varying amount
+    unsigned long t = 0;
+    int wrong = 0;
+    for (int i = 0; i < 20000; i++) {
+        t += 17 + (i * 7) % 23;
+        host::setMillis(t);
+        screen.update();
+        if (screen.getCurrentFrame() != idleFrameAt(t)) wrong++;
+    }
+    CHECK_EQ(wrong, 0);
+    // XOR of two identical layers: in step means an empty matrix
+    CHECK_FRAME(screen.getMatrix(), 0u, 0u, 0u);
+}
+
+TEST(timelineControlsMoveEveryLayer) {
+    TinyScreen screen;
+    screen.begin();
+    int top = screen.addLayer();
+    screen.followTimeline();
+    screen.followTimelineOnLayer(top);
+    screen.play(idle, LOOP);
+    screen.playOnLayer(top, idle, LOOP, 2, 4);
+    Timeline& master = screen.getTimeline();
+
+    host::setMillis(320);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 2);
+
+    master.pause();
+    CHECK(screen.needsUpdate());
+    screen.update();
+    host::setMillis(5000);
+    CHECK(!screen.needsUpdate());
+    CHECK_EQ(screen.nextDeadline(), 5000ul + NO_DEADLINE_MS);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 2);
+
+    master.resume();
+    master.seek(610);                    // Everything started at timeline 0
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+
+    master.setRate(2.0f);
+    screen.update();
+    CHECK_EQ(screen.nextDeadline() - millis(), 70ul);   // 140 timeline ms left of frame 4
+    host::advanceMillis(70);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 1);
+}
+
+TEST(timelineSeekRevivesCompletedLayer) {
+    TinyScreen screen;
+    screen.begin();
+    screen.followTimeline();
+    screen.play(idle, ONCE);
+
+    host::setMillis(800);
+    screen.update();
+    CHECK(screen.isComplete());
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+
+    screen.getTimeline().seek(310);
+    screen.update();
+    CHECK(screen.isPlaying());
+    CHECK_EQ(screen.getCurrentFrame(), 2);
+}
+
+TEST(layerSeekAndLeaveWhileFollowing) {
+    TinyScreen screen;
+    screen.begin();
+    screen.followTimeline();
+    screen.play(idle, LOOP);
+
+    host::setMillis(100);
+    screen.seekToFrame(3);               // Only this layer's start moves
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 3);
+    host::setMillis(250);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 4);
+
+    // Leaving keeps the frame and carries on free-running
+    screen.leaveTimeline();
+    screen.getTimeline().pause();
+    host::setMillis(400);
+    screen.update();
+    CHECK_EQ(screen.getCurrentFrame(), 1);
+}
+
+TEST(timelineRateRoundsUpDeadline) {
+    Timeline master;
+    master.setRate(0.3f);
+    host::setMillis(0);
+    CHECK_EQ(master.msUntil(100, 0), 334ul);
+    CHECK(master.timeAt(334) >= 100ul);
+    master.setRate(0.0f);
+    CHECK_EQ(master.msUntil(100, 0), NO_DEADLINE_MS);
+}
+
+// Plain tables can hold 0 ms frames; they count as 1 ms, so a following
+// layer still has a loop length to divide by
+static const uint32_t zeroTimes[][4] = {
+    {0x80000000, 0, 0, 0},
+    {0x40000000, 0, 0, 0}
+};
+
+TEST(zeroMsFramesFollowTheTimeline) {
+    TinyScreen screen;
+    screen.begin();
+    screen.followTimeline();
+    screen.play(zeroTimes, LOOP);
+    CHECK(screen.isPlaying());
+    CHECK_EQ(screen.getTotalDuration(), 2);
+
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), zeroTimes[0][0], 0, 0);
+    host::setMillis(1);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), zeroTimes[1][0], 0, 0);
+    host::setMillis(2);
+    screen.update();
+    CHECK_FRAME(screen.getMatrix(), zeroTimes[0][0], 0, 0);
+
+    screen.play(zeroTimes, BOOMERANG);
+    screen.seekToFrame(2);
+    host::setMillis(10);
+    screen.update();
+    CHECK(screen.isPlaying());
+}
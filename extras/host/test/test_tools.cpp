@@ -0,0 +1,69 @@
+// test_tools.cpp
+// Editor import and frame optimization used by the tfpack converter
+#include <string>
+#include "HostTest.h"
+#include "AnimationImport.h"
+#include "idle.h"
+
+static const char* const exported =
+    "// exported by the editor\n"
+    "const uint32_t blinky[][4] = {\n"
+    "\t{\n\t\t0xfff00000,\n\t\t0x0,\n\t\t0x0,\n\t\t100\n\t},\n"
+    "\t{\n\t\t0xfff00000,\n\t\t0x0,\n\t\t0x0,\n\t\t50\n\t},\n"
+    "\t{\n\t\t0x0,\n\t\t0x0,\n\t\t0xfffu,\n\t\t200\n\t}\n"
+    "};\n"
+    "/* const uint32_t ignored[][4] = { { 1, 2, 3, 4 } }; */\n"
+    "const uint32_t second[2][4] = { { 1, 2, 3, 40 }, { 4, 5, 6, 80 } };\n";
+
+TEST(parseHeaderReadsEveryTable) {
+    std::vector<tfpack::NamedAnimation> anims = tfpack::parseHeader(exported);
+    CHECK_EQ((int)anims.size(), 2);
+    CHECK(anims[0].name == "blinky");
+    CHECK_EQ((int)anims[0].frames.size(), 3);
+    CHECK_EQ(anims[0].frames[2].words[2], 0xFFFu);
+    CHECK_EQ(anims[0].frames[2].ms, 200u);
+    CHECK(anims[1].name == "second");
+    CHECK_EQ(anims[1].frames[1].words[0], 4u);
+}
+
+TEST(mergeRepeatsSumsDurations) {
+    std::vector<tfpack::Frame> frames = tfpack::parseHeader(exported)[0].frames;
+    std::vector<tfpack::Frame> merged = tfpack::mergeRepeats(frames);
+    CHECK_EQ((int)merged.size(), 2);
+    CHECK_EQ(merged[0].ms, 150u);
+    CHECK_EQ(merged[1].ms, 200u);
+}
+
+TEST(idleHasThreeUniqueFrames) {
+    // Frames 2 and 4 are the same picture, but not consecutive
+    std::vector<tfpack::Frame> frames = tfpack::framesOf(idle);
+    CHECK_EQ((int)tfpack::mergeRepeats(frames).size(), 4);
+    CHECK_EQ((int)tfpack::uniqueCount(frames), 3);
+    CHECK_EQ((int)tfpack::firstOccurrences(frames)[3], 1);
+}
+
+TEST(parseHeaderReadsZeroPaddedDecimals) {
+    // A leading zero is not octal; only 0x switches to hex
+    std::vector<tfpack::NamedAnimation> anims = tfpack::parseHeader(
+        "const uint32_t padded[][4] = { { 0x10, 0X0A, 09, 0100 } };");
+    CHECK_EQ((int)anims[0].frames.size(), 1);
+    CHECK_EQ(anims[0].frames[0].words[0], 16u);
+    CHECK_EQ(anims[0].frames[0].words[1], 10u);
+    CHECK_EQ(anims[0].frames[0].words[2], 9u);
+    CHECK_EQ(anims[0].frames[0].ms, 100u);
+}
+
+TEST(poolStepsShareFramesAcrossAnimations) {
+    std::vector<tfpack::Frame> pool;
+    std::vector<FrameStep> first = tfpack::poolSteps(pool, tfpack::framesOf(idle));
+    CHECK_EQ((int)pool.size(), 3);
+    CHECK_EQ((int)first[3].frame, 1);
+    CHECK_EQ((int)first[0].ms, 300);
+
+    // A second animation reuses idle's pictures and adds one
+    std::vector<tfpack::Frame> other = { {{idle[2][0], idle[2][1], idle[2][2]}, 80}, {{0, 0, 1}, 40} };
+    std::vector<FrameStep> second = tfpack::poolSteps(pool, other);
+    CHECK_EQ((int)pool.size(), 4);
+    CHECK_EQ((int)second[0].frame, 2);
+    CHECK_EQ((int)second[1].frame, 3);
+}
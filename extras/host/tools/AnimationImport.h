@@ -0,0 +1,79 @@
+// AnimationImport.h
+// Reads LED Matrix Editor output on the host: exported .h files
+#pragma once
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "AnimationPacker.h"
+
+namespace tfpack {
+
+struct NamedAnimation {
+    std::string name;
+    std::vector<Frame> frames;
+};
+
+//------------------------------------------------------------------------------
+// Exported headers: const uint32_t name[][4] = { {w0, w1, w2, ms}, ... };
+//------------------------------------------------------------------------------
+
+inline std::string stripComments(const std::string& text) {
+    std::string out;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text.compare(i, 2, "//") == 0) {
+            while (i < text.size() && text[i] != '\n') i++;
+        } else if (text.compare(i, 2, "/*") == 0) {
+            size_t end = text.find("*/", i + 2);
+            i = (end == std::string::npos) ? text.size() : end + 1;
+            continue;
+        }
+        if (i < text.size()) out += text[i];
+    }
+    return out;
+}
+
+inline std::vector<NamedAnimation> parseHeader(const std::string& source) {
+    std::string text = stripComments(source);
+    std::regex decl("uint32_t\\s+(\\w+)\\s*\\[\\s*\\d*\\s*\\]\\s*\\[\\s*4\\s*\\]\\s*=\\s*\\{");
+    std::vector<NamedAnimation> result;
+
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), decl); it != std::sregex_iterator(); ++it) {
+        NamedAnimation anim;
+        anim.name = (*it)[1];
+
+        // Numbers up to the brace that closes the table
+        size_t pos = it->position() + it->length();
+        int depth = 1;
+        std::vector<uint32_t> values;
+        while (pos < text.size() && depth > 0) {
+            char c = text[pos];
+            if (c == '{') { depth++; pos++; }
+            else if (c == '}') { depth--; pos++; }
+            else if (isdigit((unsigned char)c)) {
+                // Decimal unless 0x, so a zero-padded "0100" ms stays 100
+                const char* start = text.c_str() + pos;
+                bool hex = start[0] == '0' && (start[1] == 'x' || start[1] == 'X');
+                char* end = nullptr;
+                values.push_back((uint32_t)strtoul(hex ? start + 2 : start, &end, hex ? 16 : 10));
+                pos = end - text.c_str();
+                while (pos < text.size() && isalpha((unsigned char)text[pos])) pos++;  // u, UL suffixes
+            } else {
+                pos++;
+            }
+        }
+        if (depth != 0 || values.size() % 4 != 0) {
+            throw std::runtime_error("malformed frame table '" + anim.name + "'");
+        }
+        for (size_t i = 0; i < values.size(); i += 4) {
+            anim.frames.push_back({{values[i], values[i + 1], values[i + 2]}, values[i + 3]});
+        }
+        result.push_back(anim);
+    }
+    return result;
+}
+
+}  // namespace tfpack
@@ -0,0 +1,190 @@
+// AnimationPacker.h
+// Host-side encoders for packed and pooled animations (formats described in src/TinyScreen.h)
+//
+//   std::vector<tfpack::Frame> frames = ...;
+//   std::vector<uint8_t> bytes = tfpack::pack(frames, 16);
+//   std::vector<FrameStep> steps = tfpack::poolSteps(pool, frames);
+#pragma once
+
+#include <stdint.h>
+#include <stdexcept>
+#include <vector>
+#include "TinyScreen.h"
+
+namespace tfpack {
+
+struct Frame {
+    uint32_t words[3];
+    uint32_t ms;
+};
+
+inline bool sameWords(const Frame& a, const Frame& b) {
+    return a.words[0] == b.words[0] && a.words[1] == b.words[1] && a.words[2] == b.words[2];
+}
+
+inline void putLE16(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back((uint8_t)v);
+    out.push_back((uint8_t)(v >> 8));
+}
+
+inline void putLE32(std::vector<uint8_t>& out, uint32_t v) {
+    putLE16(out, v & 0xFFFF);
+    putLE16(out, v >> 16);
+}
+
+// Zero-run code the 12 bytes of an XOR delta
+inline void appendRecord(std::vector<uint8_t>& out, const uint32_t delta[3]) {
+    uint8_t bytes[12];
+    for (int i = 0; i < 12; i++) {
+        bytes[i] = (uint8_t)(delta[i >> 2] >> (24 - 8 * (i & 3)));
+    }
+
+    int i = 0;
+    while (i < 12) {
+        int run = 0;
+        if (bytes[i] == 0) {
+            while (i + run < 12 && bytes[i + run] == 0) run++;
+            // A lone zero between changed bytes is cheaper as a literal
+            if (!(run == 1 && i > 0 && i + 1 < 12)) {
+                out.push_back((uint8_t)(0x80 | (run - 1)));
+                i += run;
+                continue;
+            }
+        }
+        // Literal run: stop before two zero bytes in a row (or a trailing zero)
+        run = 0;
+        while (i + run < 12) {
+            if (bytes[i + run] == 0 &&
+                (i + run + 1 >= 12 || bytes[i + run + 1] == 0)) break;
+            run++;
+        }
+        out.push_back((uint8_t)(run - 1));
+        for (int k = 0; k < run; k++) out.push_back(bytes[i + k]);
+        i += run;
+    }
+}
+
+// Encode frames; keyframes every keyframeInterval frames bound the cost of
+// jumping or playing backward
+inline std::vector<uint8_t> pack(const std::vector<Frame>& frames, int keyframeInterval = 16) {
+    if (frames.empty() || frames.size() > 0xFFFF) {
+        throw std::runtime_error("packed animations hold 1 to 65535 frames");
+    }
+    if (keyframeInterval < 1 || keyframeInterval > 255) {
+        throw std::runtime_error("keyframe interval must be 1 to 255");
+    }
+
+    bool uniform = true;
+    bool wide = false;
+    for (const Frame& f : frames) {
+        if (f.ms == 0) throw std::runtime_error("frame durations must be at least 1 ms");
+        if (f.ms != frames[0].ms) uniform = false;
+        if (f.ms > 0xFFFF) wide = true;
+    }
+
+    std::vector<uint8_t> out;
+    out.push_back(PACKED_FORMAT);
+    out.push_back((uint8_t)((uniform ? PACKED_UNIFORM_TIMING : 0) | (wide ? PACKED_WIDE_TIMING : 0)));
+    putLE16(out, (uint32_t)frames.size());
+    out.push_back((uint8_t)keyframeInterval);
+    out.push_back(0);
+
+    size_t timings = uniform ? 1 : frames.size();
+    for (size_t i = 0; i < timings; i++) {
+        if (wide) putLE32(out, frames[i].ms);
+        else putLE16(out, frames[i].ms);
+    }
+
+    // Records first, so keyframe offsets are known
+    std::vector<uint8_t> records;
+    std::vector<uint32_t> keyOffsets;
+    uint32_t previous[3] = {0, 0, 0};
+    for (size_t i = 0; i < frames.size(); i++) {
+        if (i % keyframeInterval == 0) {
+            keyOffsets.push_back((uint32_t)records.size());
+            previous[0] = previous[1] = previous[2] = 0;
+        }
+        uint32_t delta[3];
+        for (int w = 0; w < 3; w++) {
+            delta[w] = frames[i].words[w] ^ previous[w];
+            previous[w] = frames[i].words[w];
+        }
+        appendRecord(records, delta);
+    }
+    if (keyOffsets.back() > 0xFFFF) {
+        throw std::runtime_error("packed frame data is over 64 KB; split the animation");
+    }
+
+    for (uint32_t offset : keyOffsets) putLE16(out, offset);
+    out.insert(out.end(), records.begin(), records.end());
+    return out;
+}
+
+// Fold runs of identical consecutive frames into one frame shown for the
+// sum of their durations
+inline std::vector<Frame> mergeRepeats(const std::vector<Frame>& frames) {
+    std::vector<Frame> out;
+    for (const Frame& f : frames) {
+        if (!out.empty() && sameWords(out.back(), f)) out.back().ms += f.ms;
+        else out.push_back(f);
+    }
+    return out;
+}
+
+// Index of each frame's first identical occurrence; frames[i] is unique
+// when uniqueOf[i] == i
+inline std::vector<size_t> firstOccurrences(const std::vector<Frame>& frames) {
+    std::vector<size_t> uniqueOf(frames.size());
+    for (size_t i = 0; i < frames.size(); i++) {
+        uniqueOf[i] = i;
+        for (size_t j = 0; j < i; j++) {
+            if (uniqueOf[j] == j && sameWords(frames[j], frames[i])) {
+                uniqueOf[i] = j;
+                break;
+            }
+        }
+    }
+    return uniqueOf;
+}
+
+inline size_t uniqueCount(const std::vector<Frame>& frames) {
+    std::vector<size_t> uniqueOf = firstOccurrences(frames);
+    size_t count = 0;
+    for (size_t i = 0; i < uniqueOf.size(); i++) {
+        if (uniqueOf[i] == i) count++;
+    }
+    return count;
+}
+
+// Index of f's picture in a shared pool, appending it when it is new
+inline size_t poolIndex(std::vector<Frame>& pool, const Frame& f) {
+    for (size_t i = 0; i < pool.size(); i++) {
+        if (sameWords(pool[i], f)) return i;
+    }
+    if (pool.size() > 0xFFFF) throw std::runtime_error("frame pools hold at most 65536 frames");
+    pool.push_back({{f.words[0], f.words[1], f.words[2]}, 0});
+    return pool.size() - 1;
+}
+
+// FrameStep list for frames drawn from (and added to) a shared pool
+inline std::vector<FrameStep> poolSteps(std::vector<Frame>& pool, const std::vector<Frame>& frames) {
+    std::vector<FrameStep> steps;
+    for (const Frame& f : frames) {
+        if (f.ms == 0 || f.ms > 0xFFFF) throw std::runtime_error("pooled frame durations must be 1 to 65535 ms");
+        steps.push_back({(uint16_t)poolIndex(pool, f), (uint16_t)f.ms});
+    }
+    return steps;
+}
+
+// Convenience for editor-style uint32_t[N][4] tables
+template<size_t N>
+std::vector<Frame> framesOf(const uint32_t (&table)[N][4]) {
+    std::vector<Frame> frames(N);
+    for (size_t i = 0; i < N; i++) {
+        for (int w = 0; w < 3; w++) frames[i].words[w] = table[i][w];
+        frames[i].ms = table[i][3];
+    }
+    return frames;
+}
+
+}  // namespace tfpack
@@ -0,0 +1,219 @@
+// tfpack.cpp
+// Converts LED Matrix Editor exports (.h) into one
+// compact header, and reports what the animations cost in flash and RAM
+//
+//   tfpack [options] input.h...
+//
+//   -o FILE        write the header to FILE (default: stdout)
+//   --packed       emit packed uint8_t[] animations instead of uint32_t[][4]
+//   --pool         emit one shared frame pool plus a FrameStep list and
+//                  const Animation per input animation
+//   --keyframe N   keyframe interval for --packed (default 16)
+//   --no-merge     keep runs of identical frames as separate frames
+//
+// The size report goes to stderr so the header can be piped.
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include "AnimationImport.h"
+
+using namespace tfpack;
+
+// sizeof(Animation) on the UNO R4 (seven 32-bit fields)
+static const size_t ANIMATION_FLASH_BYTES = 28;
+
+struct Options {
+    const char* output = nullptr;
+    bool packed = false;
+    bool pool = false;
+    int keyframe = 16;
+    bool merge = true;
+    std::vector<std::string> inputs;
+};
+
+static void usage() {
+    fprintf(stderr,
+        "usage: tfpack [-o FILE] [--packed | --pool] [--keyframe N] [--no-merge] input.h...\n");
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open " + path);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+// File name without directory or extension, made into a C identifier
+static std::string identifierFor(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string stem = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    stem = stem.substr(0, stem.find('.'));
+    std::string id;
+    for (char c : stem) id += isalnum((unsigned char)c) ? c : '_';
+    if (id.empty() || isdigit((unsigned char)id[0])) id = "anim_" + id;
+    return id;
+}
+
+static std::vector<NamedAnimation> load(const std::string& path) {
+    std::string text = readFile(path);
+    std::vector<NamedAnimation> found = parseHeader(text);
+    if (found.empty()) throw std::runtime_error(path + ": no uint32_t name[][4] table found");
+    return found;
+}
+
+static void writePlain(FILE* out, const NamedAnimation& anim) {
+    // constexpr, so the table can also be given to DESCRIBE_ANIMATION
+    fprintf(out, "constexpr uint32_t %s[][4] = {\n", anim.name.c_str());
+    for (size_t i = 0; i < anim.frames.size(); i++) {
+        const Frame& f = anim.frames[i];
+        fprintf(out, "\t{ 0x%08x, 0x%08x, 0x%08x, %u }%s\n",
+                f.words[0], f.words[1], f.words[2], f.ms,
+                i + 1 < anim.frames.size() ? "," : "");
+    }
+    fprintf(out, "};\n");
+}
+
+static void writePacked(FILE* out, const std::string& name, const std::vector<uint8_t>& bytes) {
+    fprintf(out, "const uint8_t %s[] = {", name.c_str());
+    for (size_t i = 0; i < bytes.size(); i++) {
+        fprintf(out, "%s0x%02x%s", (i % 12 == 0) ? "\n\t" : " ", bytes[i],
+                i + 1 < bytes.size() ? "," : "");
+    }
+    fprintf(out, "\n};\n");
+}
+
+static void writePool(FILE* out, const std::string& name, const std::vector<Frame>& pool) {
+    fprintf(out, "const uint32_t %s[][3] = {\n", name.c_str());
+    for (size_t i = 0; i < pool.size(); i++) {
+        const Frame& f = pool[i];
+        fprintf(out, "\t{ 0x%08x, 0x%08x, 0x%08x }%s  // %zu\n",
+                f.words[0], f.words[1], f.words[2], i + 1 < pool.size() ? "," : " ", i);
+    }
+    fprintf(out, "};\n");
+}
+
+static void writeSteps(FILE* out, const std::string& name, const std::string& poolName,
+                       const std::vector<FrameStep>& steps) {
+    fprintf(out, "const FrameStep %s_steps[] = {", name.c_str());
+    for (size_t i = 0; i < steps.size(); i++) {
+        fprintf(out, "%s{ %u, %u }%s", (i % 6 == 0) ? "\n\t" : " ", steps[i].frame, steps[i].ms,
+                i + 1 < steps.size() ? "," : "");
+    }
+    fprintf(out, "\n};\n");
+    fprintf(out, "const Animation %s(%s, %s_steps);\n", name.c_str(), poolName.c_str(), name.c_str());
+}
+
+static bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            opt.output = argv[++i];
+        } else if (strcmp(argv[i], "--packed") == 0) {
+            opt.packed = true;
+        } else if (strcmp(argv[i], "--pool") == 0) {
+            opt.pool = true;
+        } else if (strcmp(argv[i], "--keyframe") == 0 && i + 1 < argc) {
+            opt.keyframe = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--no-merge") == 0) {
+            opt.merge = false;
+        } else if (argv[i][0] == '-') {
+            return false;
+        } else {
+            opt.inputs.push_back(argv[i]);
+        }
+    }
+    return !opt.inputs.empty() && !(opt.packed && opt.pool);
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+
+    try {
+        std::vector<NamedAnimation> anims;
+        std::set<std::string> names;
+        for (const std::string& path : opt.inputs) {
+            for (NamedAnimation& anim : load(path)) {
+                if (!names.insert(anim.name).second) {
+                    throw std::runtime_error("animation name '" + anim.name + "' is used twice");
+                }
+                anims.push_back(anim);
+            }
+        }
+
+        FILE* out = opt.output ? fopen(opt.output, "w") : stdout;
+        if (!out) throw std::runtime_error(std::string("cannot write ") + opt.output);
+
+        fprintf(out, "// Generated by tfpack from the LED Matrix Editor output; edit the source, not this file\n");
+        fprintf(out, "#pragma once\n\n");
+        fprintf(out, opt.pool ? "#include \"TinyScreen.h\"\n" : "#include <stdint.h>\n");
+
+        std::vector<size_t> originalCounts;
+        for (const NamedAnimation& anim : anims) originalCounts.push_back(anim.frames.size());
+
+        // Pooled output shares one frame table between every animation
+        std::string poolName = (opt.output ? identifierFor(opt.output) : std::string("pool")) + "_frames";
+        std::vector<Frame> pool;
+        std::vector<std::vector<FrameStep>> steps;
+        if (opt.pool) {
+            for (NamedAnimation& anim : anims) {
+                if (opt.merge) anim.frames = mergeRepeats(anim.frames);
+                steps.push_back(poolSteps(pool, anim.frames));
+            }
+            fprintf(out, "\n");
+            writePool(out, poolName, pool);
+        }
+
+        fprintf(stderr, "%-20s %7s %7s %7s %9s %9s\n",
+                "animation", "frames", "merged", "unique", "exported", "emitted");
+        size_t exportedTotal = 0, emittedTotal = 0;
+
+        for (size_t a = 0; a < anims.size(); a++) {
+            NamedAnimation& anim = anims[a];
+            size_t original = (opt.pool ? originalCounts[a] : anim.frames.size());
+            size_t exported = original * 4 * sizeof(uint32_t);
+            if (opt.merge && !opt.pool) anim.frames = mergeRepeats(anim.frames);
+
+            size_t emitted;
+            fprintf(out, "\n");
+            if (opt.pool) {
+                writeSteps(out, anim.name, poolName, steps[a]);
+                emitted = steps[a].size() * sizeof(FrameStep) + ANIMATION_FLASH_BYTES;
+            } else if (opt.packed) {
+                std::vector<uint8_t> bytes = pack(anim.frames, opt.keyframe);
+                writePacked(out, anim.name, bytes);
+                emitted = bytes.size();
+            } else {
+                writePlain(out, anim);
+                emitted = anim.frames.size() * 4 * sizeof(uint32_t);
+            }
+
+            fprintf(stderr, "%-20s %7zu %7zu %7zu %9zu %9zu\n", anim.name.c_str(),
+                    original, anim.frames.size(), uniqueCount(anim.frames), exported, emitted);
+            exportedTotal += exported;
+            emittedTotal += emitted;
+        }
+        if (opt.pool) {
+            size_t poolBytes = pool.size() * 3 * sizeof(uint32_t);
+            fprintf(stderr, "%-20s %7s %7s %7zu %9s %9zu\n", poolName.c_str(), "", "", pool.size(), "", poolBytes);
+            emittedTotal += poolBytes;
+        }
+
+        if (out != stdout) fclose(out);
+
+        fprintf(stderr, "\nFlash: %zu bytes (%zu as exported, %+ld)\n",
+                emittedTotal, exportedTotal, (long)emittedTotal - (long)exportedTotal);
+        fprintf(stderr, "RAM:   0 bytes - the tables are const and stay in flash%s\n",
+                opt.packed ? "; frames decode into each layer's own 12-byte buffer" : "");
+    } catch (const std::exception& e) {
+        fprintf(stderr, "tfpack: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -11,7 +11,8 @@
 #include "TinyScreen.h"
 
 // TinyScreen.h defines:
-// - TinyScreen (main unified class)
+// - TinyScreen (main unified class, MAX_LAYERS animation layers)
+// - TinyScreenT<N> (TinyScreen with N animation layers)
 // - TinyFilmFestival (alias for TinyScreen - backward compat)
 // - CombinedFilmFestival (backward compat wrapper)
 // - Animation (frame data wrapper)
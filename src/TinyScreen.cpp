@@ -2,6 +2,140 @@
 // Implementation of the unified TinyScreen class
 #include "TinyScreen.h"
 
+// Stage timing hooks - expand to nothing unless TINYSCREEN_STATS is enabled
+#if TINYSCREEN_STATS
+#define STATS_BEGIN(t)          unsigned long t = micros()
+#define STATS_END(stage, t)     stats.stage.record((uint32_t)(micros() - (t)))
+#define STATS_COUNT(counter)    stats.counter++
+#else
+#define STATS_BEGIN(t)
+#define STATS_END(stage, t)
+#define STATS_COUNT(counter)
+#endif
+
+//==============================================================================
+// Frame Packing Helpers
+//==============================================================================
+//
+// A frame is 96 bits across 3 words, MSB first: LED 0 is bit 31 of frame[0].
+// Each display row is a 12-bit field, so rows 2 and 5 straddle two words.
+// Row bitmaps keep column 0 in bit 11 so a row copies straight into its field.
+
+static inline uint16_t colBit(int col) {
+    return (uint16_t)(0x800 >> col);
+}
+
+static void packRows(const uint16_t rows[8], uint32_t frame[3]) {
+    frame[0] = ((uint32_t)rows[0] << 20) | ((uint32_t)rows[1] << 8) | ((uint32_t)rows[2] >> 4);
+    frame[1] = ((uint32_t)rows[2] << 28) | ((uint32_t)rows[3] << 16) | ((uint32_t)rows[4] << 4) | ((uint32_t)rows[5] >> 8);
+    frame[2] = ((uint32_t)rows[5] << 24) | ((uint32_t)rows[6] << 12) | (uint32_t)rows[7];
+}
+
+static void unpackRows(const uint32_t frame[3], uint16_t rows[8]) {
+    rows[0] = (uint16_t)((frame[0] >> 20) & 0xFFF);
+    rows[1] = (uint16_t)((frame[0] >> 8) & 0xFFF);
+    rows[2] = (uint16_t)(((frame[0] << 4) | (frame[1] >> 28)) & 0xFFF);
+    rows[3] = (uint16_t)((frame[1] >> 16) & 0xFFF);
+    rows[4] = (uint16_t)((frame[1] >> 4) & 0xFFF);
+    rows[5] = (uint16_t)(((frame[1] << 8) | (frame[2] >> 24)) & 0xFFF);
+    rows[6] = (uint16_t)((frame[2] >> 12) & 0xFFF);
+    rows[7] = (uint16_t)(frame[2] & 0xFFF);
+}
+
+// Move a frame by (dx, dy) with clipping, one 12-bit row at a time
+static void offsetFrame(const uint32_t src[3], int dx, int dy, uint32_t dst[3]) {
+    uint16_t srcRows[8];
+    uint16_t dstRows[8];
+    unpackRows(src, srcRows);
+    
+    for (int row = 0; row < 8; row++) {
+        int srcRow = row - dy;
+        uint16_t bits = 0;
+        if (srcRow >= 0 && srcRow < 8) {
+            bits = srcRows[srcRow];
+            // Column 0 is bit 11, so moving right is a right shift
+            if (dx >= 12 || dx <= -12) {
+                bits = 0;
+            } else if (dx > 0) {
+                bits >>= dx;
+            } else if (dx < 0) {
+                bits = (uint16_t)((bits << -dx) & 0xFFF);
+            }
+        }
+        dstRows[row] = bits;
+    }
+    packRows(dstRows, dst);
+}
+
+//==============================================================================
+// Rotation Helpers
+//==============================================================================
+//
+// 180° reverses each row and the row order. 90° and 270° show the center
+// 8x8 square (columns 2-9) transposed, so they reduce to an 8x8 bit-matrix
+// transpose plus, for 90°, a bit reversal of each output row.
+
+// Byte bit-reversal table, generated at compile time
+struct BitReverseTable {
+    uint8_t bits[256];
+
+    constexpr BitReverseTable() : bits() {
+        for (int v = 0; v < 256; v++) {
+            uint8_t r = 0;
+            for (int b = 0; b < 8; b++) {
+                if (v & (1 << b)) r |= (uint8_t)(0x80 >> b);
+            }
+            bits[v] = r;
+        }
+    }
+};
+
+static constexpr BitReverseTable bitReverse;
+
+// Transpose an 8x8 bit matrix: row i is byte i from the top, column 0 is the MSB
+static inline uint64_t transpose8x8(uint64_t x) {
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+// Rotate 8 row bitmaps (rotation: 0=0°, 1=90°, 2=180°, 3=270°)
+static void rotateRows(const uint16_t src[8], uint16_t dst[8], uint8_t rotation) {
+    switch (rotation) {
+        case 1:
+        case 3: {
+            uint64_t square = 0;
+            for (int row = 0; row < 8; row++) {
+                square = (square << 8) | ((src[row] >> 2) & 0xFF);
+            }
+            square = transpose8x8(square);
+            for (int row = 0; row < 8; row++) {
+                int srcByte = (rotation == 1) ? row : 7 - row;
+                uint8_t bits = (uint8_t)(square >> (56 - 8 * srcByte));
+                if (rotation == 1) bits = bitReverse.bits[bits];
+                dst[row] = (uint16_t)bits << 2;
+            }
+            break;
+        }
+        case 2:
+            for (int row = 0; row < 8; row++) {
+                uint16_t v = src[7 - row];
+                dst[row] = (uint16_t)((bitReverse.bits[v & 0xFF] << 4) | (bitReverse.bits[v >> 8] >> 4));
+            }
+            break;
+        default:
+            for (int row = 0; row < 8; row++) {
+                dst[row] = src[row];
+            }
+            break;
+    }
+}
+
 //==============================================================================
 // AnimationLayer Implementation
 //==============================================================================
@@ -9,7 +143,6 @@
 AnimationLayer::AnimationLayer() :
     isCustomSpeed(false),
     customSpeedInterval(0),
-    originalTimings(nullptr),
     frameCount(0),
     currentFrameIndex(0),
     startFrameIndex(0),
@@ -20,39 +153,48 @@ AnimationLayer::AnimationLayer() :
     defaultPlayingBackward(false),
     speedDirectionOverride(false),
     useSpeedMultiplier(false),
-    speedMultiplier(1.0f),
+    speedScale(65536),
+    currentInterval(0),
     currentAnimation(nullptr),
+    packedData(nullptr),
+    framePool(nullptr),
+    frameSequence(nullptr),
+    frameStartMs(nullptr),
     lastUpdateTime(0),
     currentMode(PLAY_ONCE),
     currentState(IDLE),
+    timingMode(TIMING_RELATIVE),
     offsetX(0),
-    offsetY(0)
+    offsetY(0),
+    positionedFrameIndex(-1),
+    blendMode(BLEND_OR),
+    zOrder(0),
+    maskFrame(nullptr),
+    brightness(255),
+    positionedMaskValid(false),
+    timeline(nullptr),
+    timelineStart(0),
+    frameEndsAt(0),
+    timelineEdits(0),
+    rangeMs(0),
+    loopLimit(0),
+    loopsDone(0),
+    finishingLoop(false),
+    decodedIndex(-1),
+    decodedPos(0)
 {
 }
 
-AnimationLayer::~AnimationLayer() {
-    cleanup();
-}
-
 void AnimationLayer::cleanup() {
-    if (originalTimings != nullptr) {
-        delete[] originalTimings;
-        originalTimings = nullptr;
-    }
     currentAnimation = nullptr;
+    packedData = nullptr;
+    framePool = nullptr;
+    frameSequence = nullptr;
+    frameStartMs = nullptr;
+    decodedIndex = -1;
     frameCount = 0;
     currentState = IDLE;
-}
-
-void AnimationLayer::copyTimings(const uint32_t frames[][4], int numFrames) {
-    if (originalTimings != nullptr) {
-        delete[] originalTimings;
-    }
-    
-    originalTimings = new uint32_t[numFrames];
-    for (int i = 0; i < numFrames; i++) {
-        originalTimings[i] = frames[i][3];
-    }
+    positionedFrameIndex = -1;
 }
 
 void AnimationLayer::start(const Animation& animation, PlayMode mode, int startFrame, int endFrame) {
@@ -62,14 +204,16 @@ void AnimationLayer::start(const Animation& animation, PlayMode mode, int startF
     isBoomerang = (mode == PLAY_BOOMERANG);
     frameCount = animation.getFrameCount();
     currentAnimation = animation.getFrames();
+    packedData = animation.getPacked();
+    framePool = animation.getPool();
+    frameSequence = animation.getSequence();
+    frameStartMs = animation.getStartTimes();
     
-    if (frameCount == 0 || currentAnimation == nullptr) {
+    if (!isValidAnimation()) {
         currentState = IDLE;
         return;
     }
     
-    copyTimings(currentAnimation, frameCount);
-    
     // Convert 1-based input to 0-based internal indices
     if (startFrame == 0 && endFrame == 0) {
         startFrameIndex = 0;
@@ -88,13 +232,52 @@ void AnimationLayer::start(const Animation& animation, PlayMode mode, int startF
 
     defaultPlayingBackward = isPlayingBackward;
     speedDirectionOverride = false;
+    if (useSpeedMultiplier) isCustomSpeed = false;   // A multiplier doesn't carry over (setSpeed(ms) does)
     useSpeedMultiplier = false;
-    speedMultiplier = 1.0f;
+    speedScale = 65536;
     
     currentFrameIndex = isPlayingBackward ? endFrameIndex : startFrameIndex;
     isReversing = false;
+    loopLimit = (mode == PLAY_ONCE) ? 1 : 0;
+    loopsDone = 0;
+    finishingLoop = false;
+    refreshInterval();
     lastUpdateTime = millis();
     currentState = PLAYING;
+    
+    if (timeline != nullptr) {
+        rangeMs = rangeDuration();
+        timelineStart = timeline->time();
+        syncToTimeline(timelineStart);
+    }
+}
+
+// Start where the previous run completed rather than now, so a late update()
+// loses no time between the two. loops = 0 keeps the mode's default.
+void AnimationLayer::startAfter(const Animation& animation, PlayMode mode, int startFrame, int endFrame, uint32_t loops) {
+    bool completed = (currentState == COMPLETED);
+    unsigned long completedAt = (timeline != nullptr) ? frameEndsAt : lastUpdateTime;
+    start(animation, mode, startFrame, endFrame);
+    if (loops != 0) setLoopCount(loops);
+    if (!completed || currentState != PLAYING) return;
+    if (timeline != nullptr) {
+        timelineStart = completedAt;
+        syncToTimeline(timeline->time());
+    } else {
+        lastUpdateTime = completedAt;
+    }
+}
+
+void AnimationLayer::finishLoop() {
+    if (loopLimit != 0) return;
+    loopLimit = loopsDone + 1;
+    finishingLoop = true;
+}
+
+void AnimationLayer::keepLooping() {
+    if (!finishingLoop || currentState == COMPLETED) return;
+    loopLimit = 0;
+    finishingLoop = false;
 }
 
 void AnimationLayer::setSpeed(int speedMs) {
@@ -106,6 +289,7 @@ void AnimationLayer::setSpeed(int speedMs) {
         isCustomSpeed = true;
         useSpeedMultiplier = false;
         customSpeedInterval = abs(speedMs);
+        refreshInterval();
         if (speedMs < 0) {
             isPlayingBackward = true;
             speedDirectionOverride = true;
@@ -118,6 +302,7 @@ void AnimationLayer::setSpeed(int speedMs) {
             lastUpdateTime = millis();
             currentState = PLAYING;
         }
+        if (timeline != nullptr) alignToTimeline(0);
     }
 }
 
@@ -129,9 +314,12 @@ void AnimationLayer::setSpeed(float multiplier) {
         return;
     }
 
+    // One divide here keeps the per-frame path to an integer multiply
+    float scale = 65536.0f / abs(multiplier);
     isCustomSpeed = true;
     useSpeedMultiplier = true;
-    speedMultiplier = abs(multiplier);
+    speedScale = scale >= 4294967040.0f ? 0xFFFFFFFF : (uint32_t)(scale + 0.5f);
+    refreshInterval();
 
     if (multiplier < 0.0f) {
         isPlayingBackward = true;
@@ -145,6 +333,7 @@ void AnimationLayer::setSpeed(float multiplier) {
         lastUpdateTime = millis();
         currentState = PLAYING;
     }
+    if (timeline != nullptr) alignToTimeline(0);
 }
 
 void AnimationLayer::pause() {
@@ -166,7 +355,8 @@ void AnimationLayer::restoreOriginalSpeed() {
     if (isCustomSpeed) {
         isCustomSpeed = false;
         useSpeedMultiplier = false;
-        speedMultiplier = 1.0f;
+        speedScale = 65536;
+        refreshInterval();
         if (speedDirectionOverride) {
             speedDirectionOverride = false;
             isPlayingBackward = defaultPlayingBackward;
@@ -175,6 +365,7 @@ void AnimationLayer::restoreOriginalSpeed() {
             lastUpdateTime = millis();
             currentState = PLAYING;
         }
+        if (timeline != nullptr) alignToTimeline(0);
     }
 }
 
@@ -184,14 +375,91 @@ void AnimationLayer::stop() {
 
 int AnimationLayer::getCurrentSpeed() const {
     if (!isValidAnimation()) return 0;
-    if (!isCustomSpeed) {
-        return originalTimings[currentFrameIndex];
+    return currentInterval;
+}
+
+unsigned long AnimationLayer::getTotalDuration() const {
+    if (!isValidAnimation()) return 0;
+    if (frameStartMs != nullptr) return frameStartMs[frameCount];
+    unsigned long total = 0;
+    for (int i = 0; i < frameCount; i++) total += frameTime(i);
+    return total;
+}
+
+const uint32_t* AnimationLayer::frameWords() const {
+    if (frameSequence != nullptr) return framePool[frameSequence[currentFrameIndex].frame];
+    if (packedData == nullptr) return currentAnimation[currentFrameIndex];
+    if (decodedIndex != currentFrameIndex) decodePacked(currentFrameIndex);
+    return decodedFrame;
+}
+
+//--- Packed animations ---
+
+static inline uint16_t readLE16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t readLE32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Byte offsets of the packed sections (see the format in TinyScreen.h)
+static inline int packedTimingCount(const uint8_t* data, int frames) {
+    return (data[1] & PACKED_UNIFORM_TIMING) ? 1 : frames;
+}
+
+static inline const uint8_t* packedKeyframes(const uint8_t* data, int frames) {
+    int width = (data[1] & PACKED_WIDE_TIMING) ? 4 : 2;
+    return data + PACKED_HEADER_SIZE + packedTimingCount(data, frames) * width;
+}
+
+static inline const uint8_t* packedRecords(const uint8_t* data, int frames) {
+    int keyframes = (frames + data[4] - 1) / data[4];
+    return packedKeyframes(data, frames) + keyframes * 2;
+}
+
+// XOR one record into frame; returns the bytes it used
+static int applyPackedRecord(const uint8_t* record, uint32_t frame[3]) {
+    int pos = 0;
+    int out = 0;
+    while (out < 12) {
+        uint8_t token = record[pos++];
+        int run = min((token & 0x7F) + 1, 12 - out);
+        if (token & 0x80) {
+            out += run;  // Unchanged bytes
+            continue;
+        }
+        for (int i = 0; i < run; i++, out++) {
+            frame[out >> 2] ^= (uint32_t)record[pos++] << (24 - 8 * (out & 3));
+        }
+    }
+    return pos;
+}
+
+uint32_t AnimationLayer::packedFrameTime(int index) const {
+    if (packedData[1] & PACKED_UNIFORM_TIMING) index = 0;
+    const uint8_t* timings = packedData + PACKED_HEADER_SIZE;
+    return (packedData[1] & PACKED_WIDE_TIMING) ? readLE32(timings + index * 4) : readLE16(timings + index * 2);
+}
+
+// Bring decodedFrame to frame index: one record when stepping forward,
+// otherwise replay from the keyframe at or before it (at most K records)
+void AnimationLayer::decodePacked(int index) const {
+    int interval = packedData[4];
+    int keyframe = index - index % interval;
+    const uint8_t* records = packedRecords(packedData, frameCount);
+
+    if (decodedIndex < keyframe || decodedIndex > index) {
+        decodedFrame[0] = 0;
+        decodedFrame[1] = 0;
+        decodedFrame[2] = 0;
+        decodedPos = readLE16(packedKeyframes(packedData, frameCount) + (keyframe / interval) * 2);
+        decodedIndex = keyframe - 1;
     }
-    if (useSpeedMultiplier) {
-        float interval = (float)originalTimings[currentFrameIndex] / speedMultiplier;
-        return (int)max(1.0f, round(interval));
+    while (decodedIndex < index) {
+        decodedPos += applyPackedRecord(records + decodedPos, decodedFrame);
+        decodedIndex++;
     }
-    return customSpeedInterval;
 }
 
 bool AnimationLayer::getFrame(uint32_t frame[3]) const {
@@ -199,92 +467,343 @@ bool AnimationLayer::getFrame(uint32_t frame[3]) const {
     
     if (offsetX == 0 && offsetY == 0) {
         // No offset — return raw frame data
-        frame[0] = currentAnimation[currentFrameIndex][0];
-        frame[1] = currentAnimation[currentFrameIndex][1];
-        frame[2] = currentAnimation[currentFrameIndex][2];
+        const uint32_t* words = frameWords();
+        frame[0] = words[0];
+        frame[1] = words[1];
+        frame[2] = words[2];
+    } else if (positionedFrameIndex == currentFrameIndex) {
+        // Same frame and offset as last time
+        frame[0] = positionedFrame[0];
+        frame[1] = positionedFrame[1];
+        frame[2] = positionedFrame[2];
     } else {
         // Apply position offset with clipping
-        const uint32_t* src = currentAnimation[currentFrameIndex];
-        frame[0] = 0;
-        frame[1] = 0;
-        frame[2] = 0;
+        offsetFrame(frameWords(), offsetX, offsetY, frame);
         
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 12; col++) {
-                // Map display pixel back to source animation pixel
-                int srcCol = col - offsetX;
-                int srcRow = row - offsetY;
-                
-                // Skip if source is out of bounds (clipping)
-                if (srcCol < 0 || srcCol >= 12 || srcRow < 0 || srcRow >= 8) continue;
-                
-                // Read source pixel
-                int srcBit = srcRow * 12 + srcCol;
-                bool pixelOn = false;
-                if (srcBit < 32) {
-                    pixelOn = (src[0] & (1UL << (31 - srcBit))) != 0;
-                } else if (srcBit < 64) {
-                    pixelOn = (src[1] & (1UL << (63 - srcBit))) != 0;
-                } else {
-                    pixelOn = (src[2] & (1UL << (95 - srcBit))) != 0;
-                }
-                
-                // Write to destination if source pixel is on
-                if (pixelOn) {
-                    int dstBit = row * 12 + col;
-                    if (dstBit < 32) {
-                        frame[0] |= (1UL << (31 - dstBit));
-                    } else if (dstBit < 64) {
-                        frame[1] |= (1UL << (63 - dstBit));
-                    } else {
-                        frame[2] |= (1UL << (95 - dstBit));
-                    }
-                }
-            }
-        }
+        positionedFrame[0] = frame[0];
+        positionedFrame[1] = frame[1];
+        positionedFrame[2] = frame[2];
+        positionedFrameIndex = currentFrameIndex;
     }
     return true;
 }
 
 void AnimationLayer::setOffset(int x, int y) {
+    if ((int8_t)x != offsetX || (int8_t)y != offsetY) {
+        positionedFrameIndex = -1;
+        positionedMaskValid = false;
+    }
     offsetX = (int8_t)x;
     offsetY = (int8_t)y;
 }
 
+void AnimationLayer::setMask(const uint32_t mask[3]) {
+    maskFrame = mask;
+    positionedMaskValid = false;
+}
+
+void AnimationLayer::getMask(uint32_t mask[3]) const {
+    if (!positionedMaskValid) {
+        static const uint32_t wholeArea[3] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
+        offsetFrame(maskFrame != nullptr ? maskFrame : wholeArea, offsetX, offsetY, positionedMask);
+        positionedMaskValid = true;
+    }
+    mask[0] = positionedMask[0];
+    mask[1] = positionedMask[1];
+    mask[2] = positionedMask[2];
+}
+
+void AnimationLayer::refreshInterval() {
+    if (!isCustomSpeed) {
+        currentInterval = frameTime(currentFrameIndex);
+    } else if (!useSpeedMultiplier) {
+        currentInterval = customSpeedInterval;
+    } else {
+        // Q16 scale, rounded to the nearest ms
+        uint64_t scaled = ((uint64_t)frameTime(currentFrameIndex) * speedScale + 0x8000) >> 16;
+        currentInterval = scaled == 0 ? 1 : (scaled > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)scaled);
+    }
+}
+
+unsigned long AnimationLayer::msUntilNextFrame(unsigned long now) const {
+    if (timeline != nullptr) {
+        if (!wantsUpdates() || !isValidAnimation()) return NO_DEADLINE_MS;
+        if (timelineEdits != timeline->getEdits()) return 0;   // Paused, sought or re-rated
+        if (currentState == COMPLETED) return NO_DEADLINE_MS;
+        return timeline->msUntil(frameEndsAt, now);
+    }
+    if (currentState != PLAYING || !isValidAnimation()) return NO_DEADLINE_MS;
+    unsigned long elapsed = now - lastUpdateTime;
+    uint32_t interval = frameInterval();
+    return elapsed >= interval ? 0 : interval - elapsed;
+}
+
 bool AnimationLayer::updateFrame() {
+    if (timeline != nullptr) {
+        if (!wantsUpdates() || !isValidAnimation()) return false;
+        unsigned long timelineNow = timeline->timeAt(millis());
+        if (timelineEdits == timeline->getEdits() &&
+            (currentState == COMPLETED || (long)(timelineNow - frameEndsAt) < 0)) return false;
+        return syncToTimeline(timelineNow);
+    }
     if (currentState != PLAYING || !isValidAnimation()) return false;
 
     unsigned long currentTime = millis();
-    uint32_t interval = 0;
-    if (isCustomSpeed && useSpeedMultiplier) {
-        float scaled = (float)originalTimings[currentFrameIndex] / speedMultiplier;
-        interval = (uint32_t)max(1.0f, round(scaled));
+    uint32_t interval = frameInterval();
+    if (currentTime - lastUpdateTime < interval) return false;
+
+    if (timingMode == TIMING_RELATIVE) {
+        // Next frame is timed from now, so any lateness is never made up
+        stepFrame();
+        lastUpdateTime = currentTime;
+        return true;
+    }
+
+    // Anchored: each frame starts exactly when the previous one was due
+    int count = endFrameIndex - startFrameIndex + 1;
+    int loopFrames = !isBoomerang ? count : (count > 1 ? 2 * count - 2 : 2);   // Steps until the layer repeats
+    unsigned long loopStart = lastUpdateTime;
+    int steps = 0;
+    do {
+        lastUpdateTime += interval;
+        stepFrame();
+        if (currentState != PLAYING || timingMode == TIMING_CATCH_UP) break;
+        if (++steps == loopFrames) {
+            // Still behind after a whole loop: the loops missed since end where
+            // they start, so drop them all and walk only what is left
+            uint32_t loopMs = lastUpdateTime - loopStart;
+            uint32_t loops = (currentTime - lastUpdateTime) / loopMs;
+            if (loopLimit != 0) {
+                uint32_t left = onLastLoop() ? 0 : loopLimit - 1 - loopsDone;
+                if (loops > left) loops = left;
+            }
+            lastUpdateTime += (unsigned long)loops * loopMs;
+            loopsDone += loops;
+        }
+        interval = frameInterval();
+    } while (currentTime - lastUpdateTime >= interval);
+    return true;
+}
+
+//--- Seeking ---
+
+uint32_t AnimationLayer::sumFrameTimes(int first, int last) const {
+    if (first > last) return 0;
+    if (frameStartMs != nullptr) return frameStartMs[last + 1] - frameStartMs[first];
+    uint32_t total = 0;
+    for (int i = first; i <= last; i++) total += frameTime(i);
+    return total;
+}
+
+uint32_t AnimationLayer::passTimeOf(int index) const {
+    return isPlayingBackward ? sumFrameTimes(index + 1, endFrameIndex) : sumFrameTimes(startFrameIndex, index - 1);
+}
+
+int AnimationLayer::frameAtTime(int first, int last, uint32_t ms, uint32_t& into) const {
+    if (frameStartMs != nullptr) {
+        // Binary search the descriptor's prefix sums for the last frame starting at or before ms
+        uint32_t target = frameStartMs[first] + ms;
+        int lo = first;
+        int hi = last;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (frameStartMs[mid] <= target) lo = mid;
+            else hi = mid - 1;
+        }
+        into = target - frameStartMs[lo];
+        return lo;
+    }
+    int index = first;
+    while (index < last && ms >= frameTime(index)) {
+        ms -= frameTime(index);
+        index++;
+    }
+    into = ms;
+    return index;
+}
+
+int AnimationLayer::frameInPass(int first, int last, uint32_t total, bool backward, uint32_t ms, uint32_t& into) const {
+    if (!backward) return frameAtTime(first, last, ms, into);
+    // The pass runs from last down; mirror the time onto the forward sums
+    int index = frameAtTime(first, last, total - 1 - ms, into);
+    into = frameTime(index) - 1 - into;
+    return index;
+}
+
+void AnimationLayer::landOnFrame(uint32_t into) {
+    if (timeline != nullptr) {
+        // Move this layer's start so the timeline lands here
+        isReversing = false;
+        if (currentState == COMPLETED) currentState = PLAYING;
+        if (usesFixedInterval()) into = (uint32_t)((uint64_t)into * customSpeedInterval / frameTime(currentFrameIndex));
+        alignToTimeline(into);
+        return;
+    }
+    // A boomerang sitting on its far end turns around on the next step
+    isReversing = isBoomerang && startFrameIndex != endFrameIndex &&
+                  currentFrameIndex == (isPlayingBackward ? startFrameIndex : endFrameIndex);
+    refreshInterval();
+    // Keep the part of the frame already passed, at the current speed
+    lastUpdateTime = millis() - (unsigned long)((uint64_t)into * currentInterval / frameTime(currentFrameIndex));
+    if (currentState == COMPLETED) currentState = PLAYING;
+}
+
+void AnimationLayer::seekToFrame(int frameNum) {
+    if (!isValidAnimation() || currentState == IDLE) return;
+    currentFrameIndex = constrain(frameNum - 1, startFrameIndex, endFrameIndex);
+    landOnFrame(0);
+}
+
+void AnimationLayer::seekToTime(unsigned long ms) {
+    if (!isValidAnimation() || currentState == IDLE) return;
+    uint32_t total = rangeDuration();
+    uint32_t t = ms < total ? ms : total - 1;
+    uint32_t into;
+    currentFrameIndex = frameInPass(startFrameIndex, endFrameIndex, total, isPlayingBackward, t, into);
+    landOnFrame(into);
+}
+
+void AnimationLayer::seekToFraction(float fraction) {
+    if (!isValidAnimation() || currentState == IDLE) return;
+    fraction = constrain(fraction, 0.0f, 1.0f);
+    seekToTime((unsigned long)(fraction * rangeDuration()));
+}
+
+//--- Timeline ---
+
+void AnimationLayer::setTimeline(const Timeline* master) {
+    if (master == timeline) return;
+    timeline = master;
+    if (master == nullptr) {
+        lastUpdateTime = millis();   // Carry on from the current frame on the layer's own timing
+        return;
+    }
+    if (!isValidAnimation() || currentState == IDLE) return;
+    // Keep the current frame; from here on it moves with the timeline
+    rangeMs = rangeDuration();
+    alignToTimeline(0);
+}
+
+// Layer time runs in authored ms scaled by setSpeed(float), or counts one
+// fixed interval per frame after setSpeed(ms)
+// Latest layer ms already reached timelineMs into the layer (inverse of toTimelineTime)
+uint32_t AnimationLayer::toLayerTime(uint32_t timelineMs) const {
+    if (usesFixedInterval() || speedScale == 65536) return timelineMs;
+    return (uint32_t)(((((uint64_t)timelineMs + 1) << 16) - 0x8001) / speedScale);
+}
+
+// Timeline ms for layerMs, rounded like refreshInterval() rounds one frame
+uint32_t AnimationLayer::toTimelineTime(uint32_t layerMs) const {
+    if (usesFixedInterval() || speedScale == 65536) return layerMs;
+    return (uint32_t)(((uint64_t)layerMs * speedScale + 0x8000) >> 16);
+}
+
+// Layer time from the start of a cycle to the start of frame index. The
+// return sweep of a boomerang (isReversing) skips both end frames.
+uint32_t AnimationLayer::cycleTimeOf(int index) const {
+    bool fixed = usesFixedInterval();
+    int farEnd = isPlayingBackward ? startFrameIndex : endFrameIndex;
+    if (!isReversing || index == farEnd) {
+        if (fixed) return (isPlayingBackward ? endFrameIndex - index : index - startFrameIndex) * customSpeedInterval;
+        return passTimeOf(index);
+    }
+    int count = endFrameIndex - startFrameIndex + 1;
+    if (fixed) {
+        int step = isPlayingBackward ? index - (startFrameIndex + 1) : (endFrameIndex - 1) - index;
+        return (count + step) * customSpeedInterval;
+    }
+    return rangeMs + (isPlayingBackward ? sumFrameTimes(startFrameIndex + 1, index - 1)
+                                        : sumFrameTimes(index + 1, endFrameIndex - 1));
+}
+
+// Layer time of one loop: a pass, plus the return sweep of a boomerang
+uint32_t AnimationLayer::loopLength(uint32_t& pass) const {
+    bool fixed = usesFixedInterval();
+    int count = endFrameIndex - startFrameIndex + 1;
+    pass = fixed ? count * customSpeedInterval : rangeMs;
+    if (!isBoomerang || count < 2) return pass;
+    return pass + (fixed ? (count - 2) * customSpeedInterval
+                         : rangeMs - frameTime(startFrameIndex) - frameTime(endFrameIndex));
+}
+
+// Move this layer's start on the timeline so it is intoMs (layer time) into the current frame now
+void AnimationLayer::alignToTimeline(uint32_t intoMs) {
+    unsigned long timelineNow = timeline->time();
+    uint32_t pass;
+    uint32_t loops = loopsDone * loopLength(pass);   // Keep the loop count
+    timelineStart = timelineNow - toTimelineTime(loops + cycleTimeOf(currentFrameIndex) + intoMs);
+    syncToTimeline(timelineNow);
+}
+
+// Frame for the time since timelineStart: one pass, or out and back for a
+// boomerang. Nothing accumulates between calls.
+bool AnimationLayer::syncToTimeline(unsigned long timelineNow) {
+    int previousFrame = currentFrameIndex;
+    AnimationState previousState = currentState;
+    timelineEdits = timeline->getEdits();
+
+    long elapsed = (long)(timelineNow - timelineStart);
+    uint32_t local = elapsed > 0 ? toLayerTime((uint32_t)elapsed) : 0;   // Not started yet: first frame
+
+    bool fixed = usesFixedInterval();
+    uint32_t pass;
+    uint32_t cycle = loopLength(pass);
+    uint32_t inner = cycle - pass;
+
+    uint32_t loops = local / cycle;
+    bool done = (loopLimit != 0 && loops >= loopLimit);
+    if (done) {
+        currentFrameIndex = (isPlayingBackward != isBoomerang) ? startFrameIndex : endFrameIndex;
+        isReversing = false;
+        loopsDone = loopLimit - 1;
+        frameEndsAt = timelineStart + toTimelineTime(loopLimit * cycle);   // When it completed
     } else {
-        interval = isCustomSpeed ? customSpeedInterval : originalTimings[currentFrameIndex];
+        loopsDone = loops;
+        uint32_t t = local - loops * cycle;
+        isReversing = (t >= pass);
+        bool backward = (isPlayingBackward != isReversing);
+        int first = isReversing ? startFrameIndex + 1 : startFrameIndex;
+        int last = isReversing ? endFrameIndex - 1 : endFrameIndex;
+        uint32_t into;
+        if (isReversing) t -= pass;
+        if (fixed) {
+            int step = t / customSpeedInterval;
+            into = t % customSpeedInterval;
+            currentFrameIndex = backward ? last - step : first + step;
+        } else {
+            currentFrameIndex = frameInPass(first, last, isReversing ? inner : pass, backward, t, into);
+        }
+        uint32_t length = fixed ? (uint32_t)customSpeedInterval : frameTime(currentFrameIndex);
+        frameEndsAt = timelineStart + toTimelineTime(local - into + length);
     }
+    if (currentState != PAUSED) currentState = done ? COMPLETED : PLAYING;
 
-    if (currentTime - lastUpdateTime < interval) return false;
+    if (currentFrameIndex != previousFrame) refreshInterval();
+    return currentFrameIndex != previousFrame || currentState != previousState;
+}
 
-    // Advance frame
+void AnimationLayer::stepFrame() {
     if (!isBoomerang) {
         if (isPlayingBackward) {
             currentFrameIndex--;
             if (currentFrameIndex < startFrameIndex) {
-                if (currentMode == PLAY_ONCE) {
+                if (onLastLoop()) {
+                    currentFrameIndex = startFrameIndex;  // Hold the last frame shown
                     currentState = COMPLETED;
-                    return true;
                 } else {
                     currentFrameIndex = endFrameIndex;
+                    loopsDone++;
                 }
             }
         } else {
             currentFrameIndex++;
             if (currentFrameIndex > endFrameIndex) {
-                if (currentMode == PLAY_ONCE) {
+                if (onLastLoop()) {
+                    currentFrameIndex = endFrameIndex;
                     currentState = COMPLETED;
-                    return true;
                 } else {
                     currentFrameIndex = startFrameIndex;
+                    loopsDone++;
                 }
             }
         }
@@ -300,68 +819,156 @@ bool AnimationLayer::updateFrame() {
             currentFrameIndex = isPlayingBackward ? currentFrameIndex + 1 : currentFrameIndex - 1;
             if (currentFrameIndex <= startFrameIndex || currentFrameIndex >= endFrameIndex) {
                 isReversing = false;
-                if (currentMode == PLAY_ONCE) {
+                currentFrameIndex = constrain(currentFrameIndex, startFrameIndex, endFrameIndex);
+                if (onLastLoop()) {
                     currentState = COMPLETED;
-                    return true;
                 } else {
                     currentFrameIndex = isPlayingBackward ? endFrameIndex : startFrameIndex;
+                    loopsDone++;
                 }
             }
         }
     }
+    refreshInterval();
+}
 
-    lastUpdateTime = currentTime;
-    return true;
+//==============================================================================
+// Timeline Implementation
+//==============================================================================
+
+// Starts in step with millis() at rate 1
+Timeline::Timeline() : originMs(0), originTime(0), rateScale(65536), edits(0), paused(false) {
+}
+
+unsigned long Timeline::timeAt(unsigned long now) const {
+    if (paused) return originTime;
+    unsigned long real = now - originMs;
+    if (rateScale == 65536) return originTime + real;
+    return originTime + (unsigned long)(((uint64_t)real * rateScale) >> 16);
+}
+
+unsigned long Timeline::msUntil(unsigned long timelineMs, unsigned long now) const {
+    if (paused || rateScale == 0) return NO_DEADLINE_MS;
+    long remaining = (long)(timelineMs - timeAt(now));
+    if (remaining <= 0) return 0;
+    // Round up so the timeline has arrived when the wait is over
+    uint64_t wait = (((uint64_t)remaining << 16) + rateScale - 1) / rateScale;
+    return wait < NO_DEADLINE_MS ? (unsigned long)wait : NO_DEADLINE_MS;
+}
+
+void Timeline::rebase(unsigned long now) {
+    originTime = timeAt(now);
+    originMs = now;
+    edits++;
+}
+
+void Timeline::pause() {
+    if (paused) return;
+    rebase(millis());
+    paused = true;
+}
+
+void Timeline::resume() {
+    if (!paused) return;
+    paused = false;
+    originMs = millis();
+    edits++;
+}
+
+void Timeline::seek(unsigned long ms) {
+    originTime = ms;
+    originMs = millis();
+    edits++;
+}
+
+void Timeline::setRate(float rate) {
+    rebase(millis());
+    rateScale = rate > 0.0f ? (uint32_t)(rate * 65536.0f + 0.5f) : 0;
 }
 
 //==============================================================================
 // TinyScreen Implementation
 //==============================================================================
 
-TinyScreen::TinyScreen() : layerCount(1), inOverlay(false), autoShow(true), ledBufferDirty(false) {
+TinyScreenBase::TinyScreenBase(AnimationLayer* layerStorage, uint8_t* orderStorage, uint8_t capacity,
+                               BlinkTimer* blinkStorage, uint8_t blinkCapacity,
+                               QueuedAnimation* queueStorage, uint8_t queueCapacity,
+                               GrayscaleState* grayStorage) :
+    layers(layerStorage), layerCapacity(capacity), layerCount(1), playingLayers(0), visibleLayers(0),
+    drawOrder(orderStorage), queued(queueStorage), queueCapacity(queueCapacity), customOrder(false), composeDirty(true), layersOnMatrix(false),
+    pushedFrameValid(false), skippedPushes(0), inOverlay(false), autoShow(true), ledBufferDirty(false),
+    blinks(blinkStorage), blinkCapacity(blinkCapacity), blinkCount(0) {
     combinedFrame[0] = 0;
     combinedFrame[1] = 0;
     combinedFrame[2] = 0;
+    for (int i = 0; i < capacity; i++) {
+        drawOrder[i] = (uint8_t)i;
+    }
+    pushedFrame[0] = 0;
+    pushedFrame[1] = 0;
+    pushedFrame[2] = 0;
     
-    // Initialize LED buffer and blink state to all off
+    // Initialize LED buffer to all off
     for (int x = 0; x < 12; x++) {
         for (int y = 0; y < 8; y++) {
             ledBuffer[x][y] = 0;
-            blinkRate[x][y] = 0;
-            lastBlinkTime[x][y] = 0;
         }
     }
+    for (int g = 0; g < MAX_BLINK_GROUPS; g++) {
+        blinkGroups[g].mask[0] = 0;
+        blinkGroups[g].mask[1] = 0;
+        blinkGroups[g].mask[2] = 0;
+        blinkGroups[g].lit = false;
+    }
+    groupFrame[0] = 0;
+    groupFrame[1] = 0;
+    groupFrame[2] = 0;
+    for (int b = 0; b < 96; b++) {
+        blinkSlot[b] = NO_BLINK_SLOT;
+    }
     
     // Initialize canvas buffer
     for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 12; col++) {
-            canvasBuffer[row][col] = 0;
-        }
+        canvasRows[row] = 0;
     }
     inCanvasDraw = false;
     strokeEnabled = true;
     fillEnabled = false;
     strokeValue = 1;
     fillValue = 1;
+    strokeShade = 255;
+    fillShade = 255;
+    
+    // Grayscale starts off (monochrome)
+    gray = grayStorage;
+    grayBits = 0;
+    brightness = 255;
     
     // Initialize text state
     textSize = 1;
     scrollOffset = 0;
     scrollSpeed = 100;  // 100ms per pixel default
     lastScrollTime = 0;
+    scrollActive = false;
     
     // Initialize rotation
     rotation = 0;
     
     // Initialize invert
     invertDisplay = false;
+    
+#if TINYSCREEN_STATS
+    stats.reset();
+#endif
 }
 
-bool TinyScreen::begin() {
+bool TinyScreenBase::begin() {
+    pushedFrameValid = false;
+    composeDirty = true;
     return matrix.begin();
 }
 
-PlayMode TinyScreen::coercePlayMode(int mode) {
+PlayMode TinyScreenBase::coercePlayMode(int mode) {
     switch (mode) {
         case PLAY_ONCE:
             return PLAY_ONCE;
@@ -376,183 +983,863 @@ PlayMode TinyScreen::coercePlayMode(int mode) {
 
 //--- Animation Mode (simple) ---
 
-void TinyScreen::play(const Animation& animation, PlayMode mode) {
-    primary().start(animation, mode, 0, 0);
+void TinyScreenBase::play(const Animation& animation, PlayMode mode) {
+    play(animation, mode, 0, 0);
 }
 
-void TinyScreen::play(const Animation& animation, PlayMode mode, int startFrame, int endFrame) {
+void TinyScreenBase::play(const Animation& animation, PlayMode mode, int startFrame, int endFrame) {
+    clearQueueOnLayer(0);
     primary().start(animation, mode, startFrame, endFrame);
+    syncLayer(0);
 }
 
-void TinyScreen::play(const Animation& animation, int mode) {
+void TinyScreenBase::play(const Animation& animation, int mode) {
     play(animation, coercePlayMode(mode));
 }
 
-void TinyScreen::play(const Animation& animation, int mode, int startFrame, int endFrame) {
+void TinyScreenBase::play(const Animation& animation, int mode, int startFrame, int endFrame) {
     play(animation, coercePlayMode(mode), startFrame, endFrame);
 }
 
-void TinyScreen::startAnimation(const Animation& animation, PlayMode mode, int startFrame, int endFrame) {
-    primary().start(animation, mode, startFrame, endFrame);
+void TinyScreenBase::startAnimation(const Animation& animation, PlayMode mode, int startFrame, int endFrame) {
+    play(animation, mode, startFrame, endFrame);
 }
 
-void TinyScreen::startAnimation(const Animation& animation, int mode, int startFrame, int endFrame) {
+void TinyScreenBase::startAnimation(const Animation& animation, int mode, int startFrame, int endFrame) {
     startAnimation(animation, coercePlayMode(mode), startFrame, endFrame);
 }
 
 //--- Layered Animations ---
 
-int TinyScreen::addLayer() {
-    if (layerCount >= MAX_LAYERS) return -1;
+int TinyScreenBase::addLayer() {
+    if (layerCount >= layerCapacity) return -1;
     return layerCount++;
 }
 
-void TinyScreen::playOnLayer(int layer, const Animation& animation, PlayMode mode) {
+void TinyScreenBase::playOnLayer(int layer, const Animation& animation, PlayMode mode) {
+    playOnLayer(layer, animation, mode, 0, 0);
+}
+
+void TinyScreenBase::playOnLayer(int layer, const Animation& animation, PlayMode mode, int startFrame, int endFrame) {
+    if (layer >= 0 && layer < layerCount) {
+        clearQueueOnLayer(layer);
+        layers[layer].start(animation, mode, startFrame, endFrame);
+        syncLayer(layer);
+    }
+}
+
+void TinyScreenBase::playOnLayer(int layer, const Animation& animation, int mode) {
+    playOnLayer(layer, animation, coercePlayMode(mode));
+}
+
+void TinyScreenBase::playOnLayer(int layer, const Animation& animation, int mode, int startFrame, int endFrame) {
+    playOnLayer(layer, animation, coercePlayMode(mode), startFrame, endFrame);
+}
+
+void TinyScreenBase::setSpeedOnLayer(int layer, int speedMs) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].setSpeed(speedMs);
+        syncLayer(layer);
+    }
+}
+
+void TinyScreenBase::setSpeedOnLayer(int layer, float speedMultiplier) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].setSpeed(speedMultiplier);
+        syncLayer(layer);
+    }
+}
+
+void TinyScreenBase::setSpeedOnLayer(int layer, double speedMultiplier) {
+    setSpeedOnLayer(layer, (float)speedMultiplier);
+}
+
+void TinyScreenBase::pauseLayer(int layer) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].pause();
+        syncLayer(layer);
+    }
+}
+
+void TinyScreenBase::resumeLayer(int layer) {
     if (layer >= 0 && layer < layerCount) {
-        layers[layer].start(animation, mode, 0, 0);
+        layers[layer].resume();
+        syncLayer(layer);
+    }
+}
+
+void TinyScreenBase::stopLayer(int layer) {
+    if (layer >= 0 && layer < layerCount) {
+        clearQueueOnLayer(layer);
+        layers[layer].stop();
+        syncLayer(layer);
+    }
+}
+
+void TinyScreenBase::setTimingModeOnLayer(int layer, TimingMode mode) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].setTimingMode(mode);
+    }
+}
+
+//--- Layer Compositing ---
+
+void TinyScreenBase::setBlendModeOnLayer(int layer, BlendMode mode) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].setBlendMode(mode);
+        syncLayer(layer);
+    }
+}
+
+BlendMode TinyScreenBase::getBlendModeOnLayer(int layer) const {
+    if (layer >= 0 && layer < layerCount) {
+        return layers[layer].getBlendMode();
+    }
+    return BLEND_OR;
+}
+
+void TinyScreenBase::setMaskOnLayer(int layer, const uint32_t mask[3]) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].setMask(mask);
+        syncLayer(layer);
+    }
+}
+
+void TinyScreenBase::setZOrderOnLayer(int layer, int z) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].setZOrder(z);
+        sortLayers();
+        syncLayer(layer);
+    }
+}
+
+int TinyScreenBase::getZOrderOnLayer(int layer) const {
+    if (layer >= 0 && layer < layerCount) {
+        return layers[layer].getZOrder();
+    }
+    return 0;
+}
+
+void TinyScreenBase::setBrightnessOnLayer(int layer, int value) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].setBrightness(value);
+        syncLayer(layer);
+    }
+}
+
+int TinyScreenBase::getBrightnessOnLayer(int layer) const {
+    if (layer >= 0 && layer < layerCount) {
+        return layers[layer].getBrightness();
+    }
+    return 255;
+}
+
+//--- Primary Layer Control ---
+
+void TinyScreenBase::setSpeed(int speedMs) {
+    primary().setSpeed(speedMs);
+    syncLayer(0);
+}
+
+void TinyScreenBase::setSpeed(float speedMultiplier) {
+    primary().setSpeed(speedMultiplier);
+    syncLayer(0);
+}
+
+void TinyScreenBase::setSpeed(double speedMultiplier) {
+    setSpeed((float)speedMultiplier);
+}
+
+void TinyScreenBase::pause() {
+    primary().pause();
+    syncLayer(0);
+}
+
+void TinyScreenBase::resume() {
+    primary().resume();
+    syncLayer(0);
+}
+
+void TinyScreenBase::restoreOriginalSpeed() {
+    primary().restoreOriginalSpeed();
+    syncLayer(0);
+}
+
+void TinyScreenBase::stop() {
+    clearQueueOnLayer(0);
+    primary().stop();
+    syncLayer(0);
+}
+
+void TinyScreenBase::setTimingMode(TimingMode mode) {
+    primary().setTimingMode(mode);
+}
+
+//--- Playlist ---
+
+bool TinyScreenBase::queue(const Animation& animation, PlayMode mode, int loops, int startFrame, int endFrame) {
+    return queueOnLayer(0, animation, mode, loops, startFrame, endFrame);
+}
+
+bool TinyScreenBase::queueOnLayer(int layer, const Animation& animation, PlayMode mode, int loops,
+                                  int startFrame, int endFrame) {
+    if (layer < 0 || layer >= layerCount || animation.getFrameCount() == 0) return false;
+    int length = getQueueLengthOnLayer(layer);
+    if (length >= queueCapacity) return false;
+
+    QueuedAnimation& entry = queueOf(layer)[length];
+    entry.animation = animation;
+    entry.loops = (uint16_t)constrain(loops, 0, 0xFFFF);
+    entry.startFrame = (int16_t)constrain(startFrame, 0, 0x7FFF);
+    entry.endFrame = (int16_t)constrain(endFrame, 0, 0x7FFF);
+    entry.mode = (uint8_t)mode;
+
+    AnimationState state = layers[layer].getState();
+    if (state == IDLE || state == COMPLETED) {
+        playQueued(layer, false);   // Nothing to wait for
+    } else {
+        layers[layer].finishLoop();
+    }
+    return true;
+}
+
+void TinyScreenBase::clearQueue() {
+    clearQueueOnLayer(0);
+}
+
+void TinyScreenBase::clearQueueOnLayer(int layer) {
+    if (layer < 0 || layer >= layerCount) return;
+    QueuedAnimation* entries = queueOf(layer);
+    for (int n = 0; n < queueCapacity && entries[n].animation.getFrameCount() != 0; n++) {
+        entries[n] = QueuedAnimation();
+    }
+    layers[layer].keepLooping();
+}
+
+int TinyScreenBase::getQueueLengthOnLayer(int layer) const {
+    if (layer < 0 || layer >= layerCount) return 0;
+    const QueuedAnimation* entries = queueOf(layer);
+    int length = 0;
+    while (length < queueCapacity && entries[length].animation.getFrameCount() != 0) length++;
+    return length;
+}
+
+// Pop the layer's next entry and start it; chained entries start the moment
+// the previous run completed, so no frame is lost to update() being late
+bool TinyScreenBase::playQueued(int layer, bool chained) {
+    if (queueCapacity == 0) return false;
+    QueuedAnimation* entries = queueOf(layer);
+    if (entries[0].animation.getFrameCount() == 0) return false;
+
+    QueuedAnimation next = entries[0];
+    int n = 1;
+    for (; n < queueCapacity && entries[n].animation.getFrameCount() != 0; n++) {
+        entries[n - 1] = entries[n];
+    }
+    entries[n - 1] = QueuedAnimation();
+
+    AnimationLayer& target = layers[layer];
+    if (chained) {
+        target.startAfter(next.animation, (PlayMode)next.mode, next.startFrame, next.endFrame, next.loops);
+    } else {
+        target.start(next.animation, (PlayMode)next.mode, next.startFrame, next.endFrame);
+        if (next.loops != 0) target.setLoopCount(next.loops);
+    }
+    if (entries[0].animation.getFrameCount() != 0) target.finishLoop();
+    syncLayer(layer);
+    return true;
+}
+
+//--- Timeline ---
+
+void TinyScreenBase::followTimeline() {
+    followTimelineOnLayer(0, timeline);
+}
+
+void TinyScreenBase::followTimelineOnLayer(int layer) {
+    followTimelineOnLayer(layer, timeline);
+}
+
+void TinyScreenBase::followTimelineOnLayer(int layer, Timeline& master) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].setTimeline(&master);
+        syncLayer(layer);
+    }
+}
+
+void TinyScreenBase::leaveTimeline() {
+    leaveTimelineOnLayer(0);
+}
+
+void TinyScreenBase::leaveTimelineOnLayer(int layer) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].setTimeline(nullptr);
+        syncLayer(layer);
+    }
+}
+
+//--- Seeking ---
+
+void TinyScreenBase::seekToFrame(int frameNum) {
+    seekToFrameOnLayer(0, frameNum);
+}
+
+void TinyScreenBase::seekToTime(unsigned long ms) {
+    seekToTimeOnLayer(0, ms);
+}
+
+void TinyScreenBase::seekToFraction(float fraction) {
+    seekToFractionOnLayer(0, fraction);
+}
+
+void TinyScreenBase::seekToFrameOnLayer(int layer, int frameNum) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].seekToFrame(frameNum);
+        syncLayer(layer);
+    }
+}
+
+void TinyScreenBase::seekToTimeOnLayer(int layer, unsigned long ms) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].seekToTime(ms);
+        syncLayer(layer);
+    }
+}
+
+void TinyScreenBase::seekToFractionOnLayer(int layer, float fraction) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].seekToFraction(fraction);
+        syncLayer(layer);
+    }
+}
+
+//--- Animation Position ---
+
+void TinyScreenBase::setPosition(int x, int y) {
+    primary().setOffset(x, y);
+    syncLayer(0);
+}
+
+void TinyScreenBase::setPositionOnLayer(int layer, int x, int y) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].setOffset(x, y);
+        syncLayer(layer);
+    }
+}
+
+int TinyScreenBase::getPositionX() const {
+    return primary().getOffsetX();
+}
+
+int TinyScreenBase::getPositionY() const {
+    return primary().getOffsetY();
+}
+
+int TinyScreenBase::getPositionXOnLayer(int layer) const {
+    if (layer >= 0 && layer < layerCount) {
+        return layers[layer].getOffsetX();
+    }
+    return 0;
+}
+
+int TinyScreenBase::getPositionYOnLayer(int layer) const {
+    if (layer >= 0 && layer < layerCount) {
+        return layers[layer].getOffsetY();
+    }
+    return 0;
+}
+
+//--- Frame Update ---
+
+void TinyScreenBase::update() {
+    // Nothing changed and no frame is due: the composite would match the matrix.
+    // No push was attempted, so the skipped-push counters stay as they are.
+    if (!needsUpdate()) return;
+
+    STATS_BEGIN(advanceStart);
+    advanceLayers();
+    STATS_END(layerAdvance, advanceStart);
+
+    if (grayBits) {
+        uint32_t planes[MAX_GRAY_BITS][3];
+        STATS_BEGIN(composeStart);
+        composeLevels(combinedFrame, planes);
+        orientPlanes(planes, true);
+        STATS_END(compositing, composeStart);
+        pushPlanes(planes);
+        composeDirty = false;
+        layersOnMatrix = (visibleLayers != 0);
+        return;
+    }
+
+    STATS_BEGIN(composeStart);
+    composeLayers(combinedFrame);
+
+    // Animations follow setRotation() like the canvas does
+    if (rotation != 0) {
+        uint16_t rows[8];
+        uint16_t rotated[8];
+        unpackRows(combinedFrame, rows);
+        rotateRows(rows, rotated, rotation);
+        packRows(rotated, combinedFrame);
+    }
+
+    // Apply invert if enabled
+    if (invertDisplay) {
+        combinedFrame[0] = ~combinedFrame[0];
+        combinedFrame[1] = ~combinedFrame[1];
+        combinedFrame[2] = ~combinedFrame[2];
+    }
+    STATS_END(compositing, composeStart);
+
+    // Display combined frame
+    pushFrame(combinedFrame);
+    composeDirty = false;
+    layersOnMatrix = (visibleLayers != 0);
+}
+
+bool TinyScreenBase::needsUpdate() const {
+    return composeDue() || layersDue(millis());
+}
+
+bool TinyScreenBase::layersDue(unsigned long now) const {
+    for (uint32_t pending = playingLayers; pending != 0; pending &= pending - 1) {
+        if (layers[__builtin_ctz(pending)].msUntilNextFrame(now) == 0) return true;
+    }
+    return false;
+}
+
+// Earliest time a layer frame, blink or scroll step is due. Wrap-safe:
+// compare with (long)(nextDeadline() - millis()) rather than >.
+unsigned long TinyScreenBase::nextDeadline() const {
+    unsigned long now = millis();
+    unsigned long wait = NO_DEADLINE_MS;
+
+    // A layer change is waiting for update() (canvas-only sketches have no layers to show)
+    if (composeDue()) return now;
+
+    for (uint32_t pending = playingLayers; pending != 0; pending &= pending - 1) {
+        wait = min(wait, layers[__builtin_ctz(pending)].msUntilNextFrame(now));
+    }
+
+    if (blinkCount > 0) {
+        long untilBlink = (int32_t)(blinks[0].due - (uint32_t)now);
+        wait = min(wait, untilBlink <= 0 ? 0UL : (unsigned long)untilBlink);
+    }
+    for (int g = 0; g < MAX_BLINK_GROUPS; g++) {
+        const BlinkGroup& group = blinkGroups[g];
+        if ((group.mask[0] | group.mask[1] | group.mask[2]) == 0) continue;
+        long untilToggle = (long)(group.due - now);
+        wait = min(wait, untilToggle <= 0 ? 0UL : (unsigned long)untilToggle);
+    }
+
+    if (scrollActive) {
+        unsigned long elapsed = now - lastScrollTime;
+        wait = min(wait, elapsed >= scrollSpeed ? 0UL : scrollSpeed - elapsed);
+    }
+
+    return now + wait;
+}
+
+// Advance the frame timer of every playing layer
+void TinyScreenBase::advanceLayers() {
+    for (uint32_t pending = playingLayers; pending != 0; pending &= pending - 1) {
+        int i = __builtin_ctz(pending);
+        layers[i].updateFrame();
+        // Playlist: the next entry takes over the moment this one completed
+        while (layers[i].isComplete() && playQueued(i, true)) {
+            layers[i].updateFrame();   // Catch up if update() ran late
+        }
+        if (!layers[i].wantsUpdates()) {
+            playingLayers &= ~(1UL << i);  // Finished a PLAY_ONCE run
+        }
     }
 }
 
-void TinyScreen::playOnLayer(int layer, const Animation& animation, PlayMode mode, int startFrame, int endFrame) {
-    if (layer >= 0 && layer < layerCount) {
-        layers[layer].start(animation, mode, startFrame, endFrame);
+// Blend all visible layers together, back to front
+void TinyScreenBase::composeLayers(uint32_t frame[3]) {
+    frame[0] = 0;
+    frame[1] = 0;
+    frame[2] = 0;
+
+    if (!customOrder) {
+        // Index order: walk the visible bits directly
+        for (uint32_t pending = visibleLayers; pending != 0; pending &= pending - 1) {
+            blendLayer(__builtin_ctz(pending), frame);
+        }
+    } else {
+        for (int n = 0; n < layerCapacity; n++) {
+            int i = drawOrder[n];
+            if (visibleLayers & (1UL << i)) {
+                blendLayer(i, frame);
+            }
+        }
     }
 }
 
-void TinyScreen::playOnLayer(int layer, const Animation& animation, int mode) {
-    playOnLayer(layer, animation, coercePlayMode(mode));
+// Combine one layer into the frame with its blend mode
+void TinyScreenBase::blendLayer(int layer, uint32_t frame[3]) {
+    uint32_t src[3];
+    if (!layers[layer].getFrame(src)) return;
+
+    switch (layers[layer].getBlendMode()) {
+        case BLEND_AND:
+            frame[0] &= src[0];
+            frame[1] &= src[1];
+            frame[2] &= src[2];
+            break;
+        case BLEND_XOR:
+            frame[0] ^= src[0];
+            frame[1] ^= src[1];
+            frame[2] ^= src[2];
+            break;
+        case BLEND_REPLACE: {
+            uint32_t mask[3];
+            layers[layer].getMask(mask);
+            frame[0] = (frame[0] & ~mask[0]) | (src[0] & mask[0]);
+            frame[1] = (frame[1] & ~mask[1]) | (src[1] & mask[1]);
+            frame[2] = (frame[2] & ~mask[2]) | (src[2] & mask[2]);
+            break;
+        }
+        case BLEND_SUBTRACT:
+            frame[0] &= ~src[0];
+            frame[1] &= ~src[1];
+            frame[2] &= ~src[2];
+            break;
+        default:
+            frame[0] |= src[0];
+            frame[1] |= src[1];
+            frame[2] |= src[2];
+            break;
+    }
+}
+
+// Rebuild drawOrder: ascending z, ties in layer index order
+void TinyScreenBase::sortLayers() {
+    customOrder = false;
+    for (int n = 0; n < layerCapacity; n++) {
+        drawOrder[n] = (uint8_t)n;
+        if (layers[n].getZOrder() != 0) customOrder = true;
+    }
+    if (!customOrder) return;
+
+    // Insertion sort (stable, at most 32 entries)
+    for (int n = 1; n < layerCapacity; n++) {
+        uint8_t layer = drawOrder[n];
+        int z = layers[layer].getZOrder();
+        int m = n - 1;
+        while (m >= 0 && layers[drawOrder[m]].getZOrder() > z) {
+            drawOrder[m + 1] = drawOrder[m];
+            m--;
+        }
+        drawOrder[m + 1] = layer;
+    }
 }
 
-void TinyScreen::playOnLayer(int layer, const Animation& animation, int mode, int startFrame, int endFrame) {
-    playOnLayer(layer, animation, coercePlayMode(mode), startFrame, endFrame);
+void TinyScreenBase::syncLayer(int layer) {
+    uint32_t bit = 1UL << layer;
+    composeDirty = true;
+    if (layers[layer].wantsUpdates()) playingLayers |= bit;
+    else playingLayers &= ~bit;
+    if (!layers[layer].isIdle()) visibleLayers |= bit;
+    else visibleLayers &= ~bit;
 }
 
-void TinyScreen::setSpeedOnLayer(int layer, int speedMs) {
-    if (layer >= 0 && layer < layerCount) {
-        layers[layer].setSpeed(speedMs);
+// Send a finished frame to the matrix, unless it is already showing
+void TinyScreenBase::pushFrame(const uint32_t frame[3]) {
+    // On/off frames (show(), displayFrame()) are full level in grayscale mode
+    if (grayBits) {
+        uint32_t planes[MAX_GRAY_BITS][3];
+        for (int k = 0; k < grayBits; k++) {
+            planes[k][0] = frame[0];
+            planes[k][1] = frame[1];
+            planes[k][2] = frame[2];
+        }
+        pushPlanes(planes);
+        return;
     }
-}
 
-void TinyScreen::setSpeedOnLayer(int layer, float speedMultiplier) {
-    if (layer >= 0 && layer < layerCount) {
-        layers[layer].setSpeed(speedMultiplier);
+    if (pushedFrameValid &&
+        frame[0] == pushedFrame[0] &&
+        frame[1] == pushedFrame[1] &&
+        frame[2] == pushedFrame[2]) {
+        skippedPushes++;
+        STATS_COUNT(framesSkipped);
+        return;
     }
-}
 
-void TinyScreen::setSpeedOnLayer(int layer, double speedMultiplier) {
-    setSpeedOnLayer(layer, (float)speedMultiplier);
-}
+    STATS_BEGIN(pushStart);
+    matrix.loadFrame(frame);
+    composeDirty = true;     // update() clears these after pushing its own composite
+    layersOnMatrix = false;
+    STATS_END(push, pushStart);
+    STATS_COUNT(framesPushed);
 
-void TinyScreen::pauseLayer(int layer) {
-    if (layer >= 0 && layer < layerCount) {
-        layers[layer].pause();
-    }
+    pushedFrame[0] = frame[0];
+    pushedFrame[1] = frame[1];
+    pushedFrame[2] = frame[2];
+    pushedFrameValid = true;
 }
 
-void TinyScreen::resumeLayer(int layer) {
-    if (layer >= 0 && layer < layerCount) {
-        layers[layer].resume();
+//==============================================================================
+// Grayscale - Bit-Angle Modulation
+//==============================================================================
+//
+// A pixel's level is split into bit-planes: plane k holds bit k of every
+// pixel's level, as an ordinary 96-bit frame. A timer loads one plane per
+// tick and plane k is shown for 2^k ticks of each 2^bits - 1 tick cycle, so
+// an LED is lit for level ticks per cycle. Tick t of the cycle shows plane
+// bits - 1 - ctz(t), which spreads the heaviest plane over every other tick
+// instead of one long block, keeping the cycle's flicker as fine as possible.
+//
+// update() and endDraw() only write planes into a back buffer; the interrupt
+// swaps it in at the start of a cycle, so a cycle never mixes two images.
+
+GrayscaleState::GrayscaleState() :
+    bamFront(0), bamSwapPending(false), bamStep(1), bamTimerOpen(false) {
+    for (int k = 0; k < MAX_GRAY_BITS; k++) {
+        for (int row = 0; row < 8; row++) {
+            canvasPlanes[k][row] = 0;
+        }
+        for (int w = 0; w < 3; w++) {
+            levelPlanes[k][w] = 0;
+            bamPlanes[0][k][w] = 0;
+            bamPlanes[1][k][w] = 0;
+        }
     }
 }
 
-void TinyScreen::stopLayer(int layer) {
-    if (layer >= 0 && layer < layerCount) {
-        layers[layer].stop();
-    }
+// The interrupt's context is the screen, so the timer must not outlive it
+GrayscaleState::~GrayscaleState() {
+    if (!bamTimerOpen) return;
+    bamTimer.stop();
+    bamTimer.close();
+    bamTimerOpen = false;
 }
 
-//--- Primary Layer Control ---
+bool TinyScreenBase::setGrayscale(int bits) {
+    if (bits <= 1) {
+        if (grayBits == 0) return true;
+        gray->bamTimer.stop();
 
-void TinyScreen::setSpeed(int speedMs) {
-    primary().setSpeed(speedMs);
-}
+        // Keep showing every lit pixel, now at full brightness
+        uint32_t frame[3] = {0, 0, 0};
+        for (int k = 0; k < grayBits; k++) {
+            frame[0] |= gray->levelPlanes[k][0];
+            frame[1] |= gray->levelPlanes[k][1];
+            frame[2] |= gray->levelPlanes[k][2];
+        }
+        grayBits = 0;
+        strokeValue = shadeToLevel(strokeShade);
+        fillValue = shadeToLevel(fillShade);
+        displayFrame(frame);
+        return true;
+    }
+    if (gray == nullptr) return false;   // Declared without grayscale storage
+    if (bits > MAX_GRAY_BITS) return false;   // Deeper cycles are too slow to look steady
+
+    if (!gray->bamTimerOpen) {
+        uint8_t type;
+        int8_t channel = FspTimer::get_available_timer(type);
+        if (channel < 0) return false;
+        if (!gray->bamTimer.begin(TIMER_MODE_PERIODIC, type, channel, 1000000.0f / GRAY_TICK_US, 0.0f,
+                            bamInterrupt, this) ||
+            !gray->bamTimer.setup_overflow_irq() || !gray->bamTimer.open()) {
+            return false;
+        }
+        gray->bamTimerOpen = true;
+    }
+    gray->bamTimer.stop();
 
-void TinyScreen::setSpeed(float speedMultiplier) {
-    primary().setSpeed(speedMultiplier);
-}
+    grayBits = (uint8_t)bits;
+    gray->bamStep = (uint8_t)getMaxLevel();   // The first tick starts a new cycle
+    strokeValue = shadeToLevel(strokeShade);
+    fillValue = shadeToLevel(fillShade);
 
-void TinyScreen::setSpeed(double speedMultiplier) {
-    setSpeed((float)speedMultiplier);
-}
+    // Lit canvas pixels start at full level
+    for (int k = 0; k < grayBits; k++) {
+        for (int row = 0; row < 8; row++) {
+            gray->canvasPlanes[k][row] = canvasRows[row];
+        }
+    }
 
-void TinyScreen::pause() {
-    primary().pause();
-}
+    // Carry the picture on the matrix over at full level
+    uint32_t frame[3] = {pushedFrame[0], pushedFrame[1], pushedFrame[2]};
+    displayFrame(frame);
+    composeDirty = true;
 
-void TinyScreen::resume() {
-    primary().resume();
+    gray->bamTimer.start();
+    return true;
 }
 
-void TinyScreen::restoreOriginalSpeed() {
-    primary().restoreOriginalSpeed();
+void TinyScreenBase::setBrightness(int value) {
+    brightness = (uint8_t)constrain(value, 0, 255);
+    if (grayBits) loadPlanes();
 }
 
-void TinyScreen::stop() {
-    primary().stop();
+// Levels round to the nearest step; anything above 0 stays visible
+uint8_t TinyScreenBase::shadeToLevel(uint8_t shade) const {
+    if (shade == 0) return 0;
+    if (grayBits == 0) return 1;
+    int maxLevel = getMaxLevel();
+    int level = (shade * maxLevel + 127) / 255;
+    return (uint8_t)(level < 1 ? 1 : level);
 }
 
-//--- Animation Position ---
-
-void TinyScreen::setPosition(int x, int y) {
-    primary().setOffset(x, y);
-}
+// The on/off composite, plus the level of the topmost layer that lit each pixel
+void TinyScreenBase::composeLevels(uint32_t frame[3], uint32_t planes[][3]) {
+    composeLayers(frame);
 
-void TinyScreen::setPositionOnLayer(int layer, int x, int y) {
-    if (layer >= 0 && layer < layerCount) {
-        layers[layer].setOffset(x, y);
+    for (int k = 0; k < grayBits; k++) {
+        planes[k][0] = 0;
+        planes[k][1] = 0;
+        planes[k][2] = 0;
     }
-}
+    for (int n = 0; n < layerCapacity; n++) {
+        int i = customOrder ? drawOrder[n] : n;
+        if (!(visibleLayers & (1UL << i))) continue;
+        if (layers[i].getBlendMode() == BLEND_SUBTRACT) continue;   // Never lights a pixel
 
-int TinyScreen::getPositionX() const {
-    return primary().getOffsetX();
-}
+        uint32_t src[3];
+        if (!layers[i].getFrame(src)) continue;
+        uint8_t level = shadeToLevel((uint8_t)layers[i].getBrightness());
+        for (int k = 0; k < grayBits; k++) {
+            for (int w = 0; w < 3; w++) {
+                if (level & (1 << k)) planes[k][w] |= src[w];
+                else planes[k][w] &= ~src[w];
+            }
+        }
+    }
 
-int TinyScreen::getPositionY() const {
-    return primary().getOffsetY();
+    // Blend modes decide which pixels are lit at all
+    for (int k = 0; k < grayBits; k++) {
+        planes[k][0] &= frame[0];
+        planes[k][1] &= frame[1];
+        planes[k][2] &= frame[2];
+    }
 }
 
-int TinyScreen::getPositionXOnLayer(int layer) const {
-    if (layer >= 0 && layer < layerCount) {
-        return layers[layer].getOffsetX();
+// Invert maps level L to max - L, which is every plane complemented
+void TinyScreenBase::orientPlanes(uint32_t planes[][3], bool rotate) {
+    for (int k = 0; k < grayBits; k++) {
+        if (rotate && rotation != 0) {
+            uint16_t rows[8];
+            uint16_t rotated[8];
+            unpackRows(planes[k], rows);
+            rotateRows(rows, rotated, rotation);
+            packRows(rotated, planes[k]);
+        }
+        if (invertDisplay) {
+            planes[k][0] = ~planes[k][0];
+            planes[k][1] = ~planes[k][1];
+            planes[k][2] = ~planes[k][2];
+        }
     }
-    return 0;
 }
 
-int TinyScreen::getPositionYOnLayer(int layer) const {
-    if (layer >= 0 && layer < layerCount) {
-        return layers[layer].getOffsetY();
+void TinyScreenBase::pushCanvasPlanes() {
+    uint32_t planes[MAX_GRAY_BITS][3];
+    STATS_BEGIN(canvasStart);
+    for (int k = 0; k < grayBits; k++) {
+        if (rotation == 0) {
+            packRows(gray->canvasPlanes[k], planes[k]);
+        } else {
+            uint16_t rows[8];
+            rotateRows(gray->canvasPlanes[k], rows, rotation);
+            packRows(rows, planes[k]);
+        }
     }
-    return 0;
+    orientPlanes(planes, false);
+    STATS_END(canvas, canvasStart);
+    pushPlanes(planes);
 }
 
-//--- Frame Update ---
-
-void TinyScreen::update() {
-    // Clear combined frame
-    combinedFrame[0] = 0;
-    combinedFrame[1] = 0;
-    combinedFrame[2] = 0;
+// Grayscale counterpart of pushFrame(): skip unchanged images
+void TinyScreenBase::pushPlanes(const uint32_t planes[][3]) {
+    bool same = pushedFrameValid;
+    for (int k = 0; k < grayBits && same; k++) {
+        same = planes[k][0] == gray->levelPlanes[k][0] &&
+               planes[k][1] == gray->levelPlanes[k][1] &&
+               planes[k][2] == gray->levelPlanes[k][2];
+    }
+    if (same) {
+        skippedPushes++;
+        STATS_COUNT(framesSkipped);
+        return;
+    }
 
-    // Update each layer and combine frames
-    uint32_t frame[3];
-    for (int i = 0; i < layerCount; i++) {
-        layers[i].updateFrame();
-        if (layers[i].getFrame(frame)) {
-            combinedFrame[0] |= frame[0];
-            combinedFrame[1] |= frame[1];
-            combinedFrame[2] |= frame[2];
+    STATS_BEGIN(pushStart);
+    pushedFrame[0] = 0;
+    pushedFrame[1] = 0;
+    pushedFrame[2] = 0;
+    for (int k = 0; k < grayBits; k++) {
+        for (int w = 0; w < 3; w++) {
+            gray->levelPlanes[k][w] = planes[k][w];
+            pushedFrame[w] |= planes[k][w];
+        }
+    }
+    loadPlanes();
+    composeDirty = true;     // update() clears these after pushing its own composite
+    layersOnMatrix = false;
+    STATS_END(push, pushStart);
+    STATS_COUNT(framesPushed);
+    pushedFrameValid = true;
+}
+
+// Write gray->levelPlanes, scaled by the global brightness, into the back buffer.
+// Scaling remaps whole levels: each input level's pixels are found with a
+// few word ANDs and written at the scaled level.
+void TinyScreenBase::loadPlanes() {
+    gray->bamSwapPending = false;   // The interrupt leaves both buffers alone until set again
+    uint32_t (*out)[3] = gray->bamPlanes[gray->bamFront ^ 1];
+
+    if (brightness == 255) {
+        for (int k = 0; k < grayBits; k++) {
+            out[k][0] = gray->levelPlanes[k][0];
+            out[k][1] = gray->levelPlanes[k][1];
+            out[k][2] = gray->levelPlanes[k][2];
+        }
+    } else {
+        for (int k = 0; k < grayBits; k++) {
+            out[k][0] = 0;
+            out[k][1] = 0;
+            out[k][2] = 0;
+        }
+        int maxLevel = getMaxLevel();
+        for (int level = 1; level <= maxLevel; level++) {
+            int scaled = (level * brightness + 127) / 255;
+            if (scaled == 0 && brightness != 0) scaled = 1;   // Dimmed, never lost
+            if (scaled == 0) continue;
+            for (int w = 0; w < 3; w++) {
+                uint32_t pixels = 0xFFFFFFFFUL;
+                for (int k = 0; k < grayBits; k++) {
+                    pixels &= (level & (1 << k)) ? gray->levelPlanes[k][w] : ~gray->levelPlanes[k][w];
+                }
+                for (int k = 0; k < grayBits; k++) {
+                    if (scaled & (1 << k)) out[k][w] |= pixels;
+                }
+            }
         }
     }
 
-    // Apply invert if enabled
-    if (invertDisplay) {
-        combinedFrame[0] = ~combinedFrame[0];
-        combinedFrame[1] = ~combinedFrame[1];
-        combinedFrame[2] = ~combinedFrame[2];
+    __sync_synchronize();     // Planes are written before the interrupt may swap them in
+    gray->bamSwapPending = true;
+}
+
+// Timer interrupt: one tick of the modulation cycle
+void TinyScreenBase::bamTick() {
+    if (++gray->bamStep > getMaxLevel()) {
+        gray->bamStep = 1;
+        if (gray->bamSwapPending) {
+            gray->bamFront ^= 1;
+            gray->bamSwapPending = false;
+        }
     }
+    matrix.loadFrame(gray->bamPlanes[gray->bamFront][grayBits - 1 - __builtin_ctz(gray->bamStep)]);
+}
 
-    // Display combined frame
-    matrix.loadFrame(combinedFrame);
+void TinyScreenBase::bamInterrupt(timer_callback_args_t* args) {
+    static_cast<TinyScreenBase*>(const_cast<void*>(args->p_context))->bamTick();
 }
 
 //==============================================================================
@@ -560,120 +1847,65 @@ void TinyScreen::update() {
 //==============================================================================
 
 // Convert canvas buffer to 96-bit frame format with rotation
-void TinyScreen::canvasBufferToFrame(uint32_t frame[3]) {
-    frame[0] = 0;
-    frame[1] = 0;
-    frame[2] = 0;
-    
-    // The LED matrix frame format is 3 x 32-bit words = 96 bits
-    // Bit 0 of frame[0] = LED at position 0 (top-left)
-    // Layout: row-major, 12 columns x 8 rows
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 12; col++) {
-            // Apply rotation to get source coordinates
-            int srcRow, srcCol;
-            switch (rotation) {
-                case 1: { // 90° clockwise (center-cropped)
-                    const int xOffset = 2; // (12 - 8) / 2
-                    const int yOffset = 2; // (12 - 8) / 2
-                    int rx = col - xOffset;     // rotated x in 0..7
-                    int ry = row + yOffset;     // rotated y in 0..11
-                    srcRow = (rx >= 0 && rx < 8 && ry >= 0 && ry < 12) ? (7 - rx) : -1;
-                    srcCol = ry;
-                    break;
-                }
-                case 2:  // 180°
-                    srcRow = 7 - row;
-                    srcCol = 11 - col;
-                    break;
-                case 3: { // 270° clockwise (center-cropped)
-                    const int xOffset = 2; // (12 - 8) / 2
-                    const int yOffset = 2; // (12 - 8) / 2
-                    int rx = col - xOffset;     // rotated x in 0..7
-                    int ry = row + yOffset;     // rotated y in 0..11
-                    srcRow = rx;
-                    srcCol = (rx >= 0 && rx < 8 && ry >= 0 && ry < 12) ? (11 - ry) : -1;
-                    break;
-                }
-                default: // 0° (no rotation)
-                    srcRow = row;
-                    srcCol = col;
-                    break;
-            }
-            
-            // Check bounds and get pixel value
-            bool pixelOn = false;
-            if (srcRow >= 0 && srcRow < 8 && srcCol >= 0 && srcCol < 12) {
-                pixelOn = canvasBuffer[srcRow][srcCol];
-            }
-            
-            if (pixelOn) {
-                int bitIndex = row * 12 + col;
-                if (bitIndex < 32) {
-                    frame[0] |= (1UL << (31 - bitIndex));
-                } else if (bitIndex < 64) {
-                    frame[1] |= (1UL << (63 - bitIndex));
-                } else {
-                    frame[2] |= (1UL << (95 - bitIndex));
-                }
-            }
-        }
+void TinyScreenBase::canvasBufferToFrame(uint32_t frame[3]) {
+    // Unrotated canvas rows are already in frame order
+    if (rotation == 0) {
+        packRows(canvasRows, frame);
+        return;
     }
+
+    uint16_t rows[8];
+    rotateRows(canvasRows, rows, rotation);
+    packRows(rows, frame);
 }
 
 // Set display rotation (0, 90, 180, or 270 degrees)
-void TinyScreen::setRotation(int degrees) {
+void TinyScreenBase::setRotation(int degrees) {
     switch (degrees) {
         case 90:  rotation = 1; break;
         case 180: rotation = 2; break;
         case 270: rotation = 3; break;
         default:  rotation = 0; break;
     }
+    composeDirty = true;
 }
 
 // Get current rotation in degrees
-int TinyScreen::getRotation() {
+int TinyScreenBase::getRotation() {
     return rotation * 90;
 }
 
 // Set display invert (flip all pixels)
-void TinyScreen::setInvert(bool invert) {
+void TinyScreenBase::setInvert(bool invert) {
     invertDisplay = invert;
+    composeDirty = true;
 }
 
 // Get current invert state
-bool TinyScreen::getInvert() {
+bool TinyScreenBase::getInvert() {
     return invertDisplay;
 }
 
 // Load a 96-bit frame into the canvas buffer (for hybrid mode)
-void TinyScreen::frameToBuffer(const uint32_t frame[3]) {
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 12; col++) {
-            int bitIndex = row * 12 + col;
-            bool pixelOn = false;
-            if (bitIndex < 32) {
-                pixelOn = (frame[0] & (1UL << (31 - bitIndex))) != 0;
-            } else if (bitIndex < 64) {
-                pixelOn = (frame[1] & (1UL << (63 - bitIndex))) != 0;
-            } else {
-                pixelOn = (frame[2] & (1UL << (95 - bitIndex))) != 0;
-            }
-            canvasBuffer[row][col] = pixelOn ? 1 : 0;
-        }
-    }
+void TinyScreenBase::frameToBuffer(const uint32_t frame[3]) {
+    unpackRows(frame, canvasRows);
 }
 
-void TinyScreen::beginDraw() {
+void TinyScreenBase::beginDraw() {
     inCanvasDraw = true;
     // Don't clear buffer here - let user call clear() explicitly if needed
 }
 
-void TinyScreen::endDraw() {
-    if (inCanvasDraw) {
+void TinyScreenBase::endDraw() {
+    if (inCanvasDraw && grayBits) {
+        pushCanvasPlanes();
+        inCanvasDraw = false;
+    } else if (inCanvasDraw) {
         // Convert buffer to frame and display
         uint32_t frame[3];
+        STATS_BEGIN(canvasStart);
         canvasBufferToFrame(frame);
+        STATS_END(canvas, canvasStart);
         
         // Apply invert if enabled
         if (invertDisplay) {
@@ -682,36 +1914,61 @@ void TinyScreen::endDraw() {
             frame[2] = ~frame[2];
         }
         
-        matrix.loadFrame(frame);
+        pushFrame(frame);
         inCanvasDraw = false;
     }
 }
 
-void TinyScreen::clear() {
+void TinyScreenBase::clear() {
     // Alias for background(OFF) - clears all pixels
     background(OFF);
 }
 
-void TinyScreen::bufferPoint(int x, int y, uint8_t value) {
+void TinyScreenBase::bufferPoint(int x, int y, uint8_t value) {
     if (x >= 0 && x < 12 && y >= 0 && y < 8) {
-        canvasBuffer[y][x] = value;
+        if (value) {
+            canvasRows[y] |= colBit(x);
+        } else {
+            canvasRows[y] &= ~colBit(x);
+        }
+        for (int k = 0; k < grayBits; k++) {
+            if (value & (1 << k)) gray->canvasPlanes[k][y] |= colBit(x);
+            else gray->canvasPlanes[k][y] &= ~colBit(x);
+        }
     }
 }
 
-void TinyScreen::set(int x, int y, bool on) {
-    if (x >= 0 && x < 12 && y >= 0 && y < 8) {
-        canvasBuffer[y][x] = on ? 1 : 0;
+// Fill columns x1..x2 of row y with one masked write, clipped once
+void TinyScreenBase::bufferSpan(int x1, int x2, int y, uint8_t value) {
+    if (y < 0 || y >= 8) return;
+    if (x1 < 0) x1 = 0;
+    if (x2 > 11) x2 = 11;
+    if (x1 > x2) return;
+
+    uint16_t mask = (uint16_t)((0xFFF >> x1) ^ (0xFFF >> (x2 + 1)));
+    if (value) {
+        canvasRows[y] |= mask;
+    } else {
+        canvasRows[y] &= ~mask;
+    }
+    for (int k = 0; k < grayBits; k++) {
+        if (value & (1 << k)) gray->canvasPlanes[k][y] |= mask;
+        else gray->canvasPlanes[k][y] &= ~mask;
     }
 }
 
-void TinyScreen::point(int x, int y) {
+void TinyScreenBase::set(int x, int y, bool on) {
+    bufferPoint(x, y, on ? (uint8_t)getMaxLevel() : 0);
+}
+
+void TinyScreenBase::point(int x, int y) {
     if (strokeEnabled) {
         bufferPoint(x, y, strokeValue);
     }
 }
 
 // Bresenham's line algorithm
-void TinyScreen::bufferLine(int x1, int y1, int x2, int y2) {
+void TinyScreenBase::bufferLine(int x1, int y1, int x2, int y2) {
     int dx = abs(x2 - x1);
     int dy = abs(y2 - y1);
     int sx = (x1 < x2) ? 1 : -1;
@@ -735,29 +1992,29 @@ void TinyScreen::bufferLine(int x1, int y1, int x2, int y2) {
     }
 }
 
-void TinyScreen::line(int x1, int y1, int x2, int y2) {
+void TinyScreenBase::line(int x1, int y1, int x2, int y2) {
     if (strokeEnabled) {
         bufferLine(x1, y1, x2, y2);
     }
 }
 
-void TinyScreen::bufferRect(int x, int y, int w, int h) {
+void TinyScreenBase::bufferRect(int x, int y, int w, int h) {
+    if (w <= 0 || h <= 0) return;
+    
     // Fill first if enabled
     if (fillEnabled) {
-        for (int row = y; row < y + h; row++) {
-            for (int col = x; col < x + w; col++) {
-                bufferPoint(col, row, fillValue);
-            }
+        int rowStart = max(y, 0);
+        int rowEnd = min(y + h - 1, 7);
+        for (int row = rowStart; row <= rowEnd; row++) {
+            bufferSpan(x, x + w - 1, row, fillValue);
         }
     }
     
     // Stroke (outline) if enabled
     if (strokeEnabled) {
         // Top and bottom edges
-        for (int col = x; col < x + w; col++) {
-            bufferPoint(col, y, strokeValue);
-            bufferPoint(col, y + h - 1, strokeValue);
-        }
+        bufferSpan(x, x + w - 1, y, strokeValue);
+        bufferSpan(x, x + w - 1, y + h - 1, strokeValue);
         // Left and right edges
         for (int row = y; row < y + h; row++) {
             bufferPoint(x, row, strokeValue);
@@ -766,12 +2023,12 @@ void TinyScreen::bufferRect(int x, int y, int w, int h) {
     }
 }
 
-void TinyScreen::rect(int x, int y, int width, int height) {
+void TinyScreenBase::rect(int x, int y, int width, int height) {
     bufferRect(x, y, width, height);
 }
 
 // Midpoint circle algorithm
-void TinyScreen::bufferCircle(int cx, int cy, int r) {
+void TinyScreenBase::bufferCircle(int cx, int cy, int r) {
     if (r <= 0) {
         if (fillEnabled) bufferPoint(cx, cy, fillValue);
         else if (strokeEnabled) bufferPoint(cx, cy, strokeValue);
@@ -783,6 +2040,9 @@ void TinyScreen::bufferCircle(int cx, int cy, int r) {
     int err = 1 - r;
     
     while (x >= y) {
+        int stepX = x;
+        int stepY = y;
+
         // Draw 8 octants for outline
         if (strokeEnabled && !fillEnabled) {
             bufferPoint(cx + x, cy + y, strokeValue);
@@ -795,16 +2055,10 @@ void TinyScreen::bufferCircle(int cx, int cy, int r) {
             bufferPoint(cx - y, cy - x, strokeValue);
         }
         
-        // Fill horizontal spans if fill enabled
+        // Rows cy±y: each y comes up once, at its widest
         if (fillEnabled) {
-            for (int i = cx - x; i <= cx + x; i++) {
-                bufferPoint(i, cy + y, fillValue);
-                bufferPoint(i, cy - y, fillValue);
-            }
-            for (int i = cx - y; i <= cx + y; i++) {
-                bufferPoint(i, cy + x, fillValue);
-                bufferPoint(i, cy - x, fillValue);
-            }
+            bufferSpan(cx - x, cx + x, cy + y, fillValue);
+            if (y != 0) bufferSpan(cx - x, cx + x, cy - y, fillValue);
         }
         
         y++;
@@ -814,15 +2068,21 @@ void TinyScreen::bufferCircle(int cx, int cy, int r) {
             x--;
             err += 2 * (y - x) + 1;
         }
+        
+        // Rows cy±x: widest on the last step before x moves in
+        if (fillEnabled && (x != stepX || x < y)) {
+            bufferSpan(cx - stepY, cx + stepY, cy + stepX, fillValue);
+            bufferSpan(cx - stepY, cx + stepY, cy - stepX, fillValue);
+        }
     }
 }
 
-void TinyScreen::circle(int cx, int cy, int diameter) {
+void TinyScreenBase::circle(int cx, int cy, int diameter) {
     int radius = diameter / 2;
     bufferCircle(cx, cy, radius);
 }
 
-void TinyScreen::ellipse(int cx, int cy, int width, int height) {
+void TinyScreenBase::ellipse(int cx, int cy, int width, int height) {
     // Simple ellipse using parametric approach
     int a = width / 2;   // semi-major axis
     int b = height / 2;  // semi-minor axis
@@ -843,18 +2103,15 @@ void TinyScreen::ellipse(int cx, int cy, int width, int height) {
     int dy = 2 * a * a * y;
     
     while (dx < dy) {
+        int stepX = x;
+        int stepY = y;
+        
         if (strokeEnabled && !fillEnabled) {
             bufferPoint(cx + x, cy + y, strokeValue);
             bufferPoint(cx - x, cy + y, strokeValue);
             bufferPoint(cx + x, cy - y, strokeValue);
             bufferPoint(cx - x, cy - y, strokeValue);
         }
-        if (fillEnabled) {
-            for (int i = cx - x; i <= cx + x; i++) {
-                bufferPoint(i, cy + y, fillValue);
-                bufferPoint(i, cy - y, fillValue);
-            }
-        }
         
         x++;
         dx += 2 * b * b;
@@ -865,6 +2122,12 @@ void TinyScreen::ellipse(int cx, int cy, int width, int height) {
             dy -= 2 * a * a;
             d1 += dx - dy + b * b;
         }
+        
+        // A row is widest on the last step before y moves in
+        if (fillEnabled && (y != stepY || dx >= dy)) {
+            bufferSpan(cx - stepX, cx + stepX, cy + stepY, fillValue);
+            if (stepY != 0) bufferSpan(cx - stepX, cx + stepX, cy - stepY, fillValue);
+        }
     }
     
     // Region 2
@@ -878,10 +2141,8 @@ void TinyScreen::ellipse(int cx, int cy, int width, int height) {
             bufferPoint(cx - x, cy - y, strokeValue);
         }
         if (fillEnabled) {
-            for (int i = cx - x; i <= cx + x; i++) {
-                bufferPoint(i, cy + y, fillValue);
-                bufferPoint(i, cy - y, fillValue);
-            }
+            bufferSpan(cx - x, cx + x, cy + y, fillValue);
+            if (y != 0) bufferSpan(cx - x, cx + x, cy - y, fillValue);
         }
         
         y--;
@@ -898,57 +2159,69 @@ void TinyScreen::ellipse(int cx, int cy, int width, int height) {
 
 //--- Style Control ---
 
-void TinyScreen::stroke(uint32_t color) {
+// Brightness of a color: its brightest channel
+static inline uint8_t colorShade(uint8_t r, uint8_t g, uint8_t b) {
+    return max(r, max(g, b));
+}
+
+static inline uint8_t colorShade(uint32_t color) {
+    return colorShade((uint8_t)(color >> 16), (uint8_t)(color >> 8), (uint8_t)color);
+}
+
+void TinyScreenBase::stroke(uint32_t color) {
     strokeEnabled = true;
-    strokeValue = (color != 0) ? 1 : 0;
+    strokeShade = colorShade(color);
+    strokeValue = shadeToLevel(strokeShade);
     matrix.stroke(color);  // Keep for text rendering
 }
 
-void TinyScreen::stroke(uint8_t r, uint8_t g, uint8_t b) {
+void TinyScreenBase::stroke(uint8_t r, uint8_t g, uint8_t b) {
     strokeEnabled = true;
-    strokeValue = (r != 0 || g != 0 || b != 0) ? 1 : 0;
+    strokeShade = colorShade(r, g, b);
+    strokeValue = shadeToLevel(strokeShade);
     matrix.stroke(r, g, b);
 }
 
-void TinyScreen::fill(uint32_t color) {
+void TinyScreenBase::fill(uint32_t color) {
     fillEnabled = true;
-    fillValue = (color != 0) ? 1 : 0;
+    fillShade = colorShade(color);
+    fillValue = shadeToLevel(fillShade);
     matrix.fill(color);  // Keep for text rendering
 }
 
-void TinyScreen::fill(uint8_t r, uint8_t g, uint8_t b) {
+void TinyScreenBase::fill(uint8_t r, uint8_t g, uint8_t b) {
     fillEnabled = true;
-    fillValue = (r != 0 || g != 0 || b != 0) ? 1 : 0;
+    fillShade = colorShade(r, g, b);
+    fillValue = shadeToLevel(fillShade);
     matrix.fill(r, g, b);
 }
 
-void TinyScreen::background(uint32_t color) {
-    // For background, fill the entire canvas buffer
-    uint8_t val = (color != 0) ? 1 : 0;
+// Fill the entire canvas buffer with one level
+static void fillCanvas(uint16_t rows[8], uint16_t planes[][8], int planeCount, uint8_t level) {
     for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 12; col++) {
-            canvasBuffer[row][col] = val;
+        rows[row] = level ? 0xFFF : 0;
+        for (int k = 0; k < planeCount; k++) {
+            planes[k][row] = (level & (1 << k)) ? 0xFFF : 0;
         }
     }
+}
+
+void TinyScreenBase::background(uint32_t color) {
+    fillCanvas(canvasRows, gray ? gray->canvasPlanes : nullptr, grayBits, shadeToLevel(colorShade(color)));
     matrix.background(color);
 }
 
-void TinyScreen::background(uint8_t r, uint8_t g, uint8_t b) {
-    uint8_t val = (r != 0 || g != 0 || b != 0) ? 1 : 0;
-    for (int row = 0; row < 8; row++) {
-        for (int col = 0; col < 12; col++) {
-            canvasBuffer[row][col] = val;
-        }
-    }
+void TinyScreenBase::background(uint8_t r, uint8_t g, uint8_t b) {
+    fillCanvas(canvasRows, gray ? gray->canvasPlanes : nullptr, grayBits, shadeToLevel(colorShade(r, g, b)));
     matrix.background(r, g, b);
 }
 
-void TinyScreen::noStroke() {
+void TinyScreenBase::noStroke() {
     strokeEnabled = false;
     matrix.noStroke();
 }
 
-void TinyScreen::noFill() {
+void TinyScreenBase::noFill() {
     fillEnabled = false;
     matrix.noFill();
 }
@@ -1080,7 +2353,7 @@ static const uint8_t font3x5[][5] PROGMEM = {
 };
 
 // Internal helper: Draw a character with scaling
-void TinyScreen::bufferCharScaled(char c, int x, int y, uint8_t value, int scale) {
+void TinyScreenBase::bufferCharScaled(char c, int x, int y, uint8_t value, int scale) {
     int index = -1;
     
     // Map character to font index
@@ -1110,18 +2383,18 @@ void TinyScreen::bufferCharScaled(char c, int x, int y, uint8_t value, int scale
 }
 
 // Draw a single character to the canvas buffer
-void TinyScreen::textChar(char c, int x, int y) {
-    uint8_t value = strokeEnabled ? strokeValue : 1;
+void TinyScreenBase::textChar(char c, int x, int y) {
+    uint8_t value = strokeEnabled ? strokeValue : (uint8_t)getMaxLevel();
     bufferCharScaled(c, x, y, value, textSize);
 }
 
 // Set text size (1 = normal 3x5, 2 = double 6x10)
-void TinyScreen::setTextSize(int size) {
+void TinyScreenBase::setTextSize(int size) {
     textSize = (size < 1) ? 1 : ((size > 2) ? 2 : size);
 }
 
 // Draw a string to the canvas buffer
-void TinyScreen::text(const char* str, int x, int y) {
+void TinyScreenBase::text(const char* str, int x, int y) {
     int charWidth = 3 * textSize + 1;  // char width + 1 pixel spacing
     int cursorX = x;
     while (*str) {
@@ -1131,33 +2404,35 @@ void TinyScreen::text(const char* str, int x, int y) {
     }
 }
 
-void TinyScreen::text(const String& str, int x, int y) {
+void TinyScreenBase::text(const String& str, int x, int y) {
     text(str.c_str(), x, y);
 }
 
 // Set scroll speed (milliseconds per pixel)
-void TinyScreen::setScrollSpeed(unsigned long ms) {
+void TinyScreenBase::setScrollSpeed(unsigned long ms) {
     scrollSpeed = ms;
 }
 
 // Reset scroll position
-void TinyScreen::resetScroll() {
+void TinyScreenBase::resetScroll() {
     scrollOffset = 0;
     lastScrollTime = millis();
+    scrollActive = false;
 }
 
 // Get current scroll offset
-int TinyScreen::getScrollOffset() {
+int TinyScreenBase::getScrollOffset() {
     return scrollOffset;
 }
 
 // Draw scrolling text - call this in your loop
-void TinyScreen::scrollText(const char* str, int y, int direction) {
+void TinyScreenBase::scrollText(const char* str, int y, int direction) {
     int charWidth = 3 * textSize + 1;
     int textWidth = strlen(str) * charWidth;
     
     // Update scroll position based on time
     unsigned long now = millis();
+    scrollActive = true;
     if (now - lastScrollTime >= scrollSpeed) {
         if (direction == SCROLL_LEFT) {
             scrollOffset++;
@@ -1178,109 +2453,128 @@ void TinyScreen::scrollText(const char* str, int y, int direction) {
     text(str, drawX, y);
 }
 
-void TinyScreen::scrollText(const String& str, int y, int direction) {
+void TinyScreenBase::scrollText(const String& str, int y, int direction) {
     scrollText(str.c_str(), y, direction);
 }
 
 // Legacy methods that use ArduinoGraphics (won't work with buffered drawing)
-void TinyScreen::textFont(const Font& font) {
+void TinyScreenBase::textFont(const Font& font) {
     matrix.textFont(font);
 }
 
-int TinyScreen::textFontWidth() {
+int TinyScreenBase::textFontWidth() {
     return textSize * 3;  // Return our font width
 }
 
-int TinyScreen::textFontHeight() {
+int TinyScreenBase::textFontHeight() {
     return textSize * 5;  // Return our font height
 }
 
 //--- Legacy Scrolling Text (ArduinoGraphics) ---
 
-void TinyScreen::beginText(int x, int y) {
+void TinyScreenBase::beginText(int x, int y) {
     matrix.beginText(x, y);
 }
 
-void TinyScreen::beginText(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
+void TinyScreenBase::beginText(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
     matrix.beginText(x, y, r, g, b);
 }
 
-void TinyScreen::beginText(int x, int y, uint32_t color) {
+void TinyScreenBase::beginText(int x, int y, uint32_t color) {
     matrix.beginText(x, y, color);
 }
 
-void TinyScreen::endText(int scrollDirection) {
+void TinyScreenBase::endText(int scrollDirection) {
     matrix.endText(scrollDirection);
+    pushedFrameValid = false;  // ArduinoGraphics drew on the matrix directly
+    composeDirty = true;
+    layersOnMatrix = false;
 }
 
-void TinyScreen::textScrollSpeed(unsigned long speed) {
+void TinyScreenBase::textScrollSpeed(unsigned long speed) {
     matrix.textScrollSpeed(speed);
 }
 
 //--- Print Interface ---
 
-size_t TinyScreen::print(const char* str) {
+size_t TinyScreenBase::print(const char* str) {
     return matrix.print(str);
 }
 
-size_t TinyScreen::print(const String& str) {
+size_t TinyScreenBase::print(const String& str) {
     return matrix.print(str);
 }
 
-size_t TinyScreen::print(char c) {
+size_t TinyScreenBase::print(char c) {
     return matrix.print(c);
 }
 
-size_t TinyScreen::print(int n) {
+size_t TinyScreenBase::print(int n) {
     return matrix.print(n);
 }
 
-size_t TinyScreen::println() {
+size_t TinyScreenBase::println() {
     return matrix.println();
 }
 
-size_t TinyScreen::println(const char* str) {
+size_t TinyScreenBase::println(const char* str) {
     return matrix.println(str);
 }
 
-size_t TinyScreen::println(const String& str) {
+size_t TinyScreenBase::println(const String& str) {
     return matrix.println(str);
 }
 
 //--- Hybrid Mode ---
 
-void TinyScreen::beginOverlay() {
+void TinyScreenBase::beginOverlay() {
     inOverlay = true;
     // Update animations first
-    combinedFrame[0] = 0;
-    combinedFrame[1] = 0;
-    combinedFrame[2] = 0;
-    
-    uint32_t frame[3];
-    for (int i = 0; i < layerCount; i++) {
-        layers[i].updateFrame();
-        if (layers[i].getFrame(frame)) {
-            combinedFrame[0] |= frame[0];
-            combinedFrame[1] |= frame[1];
-            combinedFrame[2] |= frame[2];
+    STATS_BEGIN(advanceStart);
+    advanceLayers();
+    STATS_END(layerAdvance, advanceStart);
+
+    STATS_BEGIN(composeStart);
+    if (grayBits) {
+        uint32_t planes[MAX_GRAY_BITS][3];
+        composeLevels(combinedFrame, planes);
+        for (int row = 0; row < 8; row++) {
+            canvasRows[row] = 0;
+        }
+        for (int k = 0; k < grayBits; k++) {
+            unpackRows(planes[k], gray->canvasPlanes[k]);
+            for (int row = 0; row < 8; row++) {
+                canvasRows[row] |= gray->canvasPlanes[k][row];
+            }
         }
+    } else {
+        composeLayers(combinedFrame);
     }
+    STATS_END(compositing, composeStart);
     
     // Load animation frame into canvas buffer for drawing on top
-    frameToBuffer(combinedFrame);
+    // (unrotated - endOverlay() rotates animation and drawing together)
+    if (!grayBits) frameToBuffer(combinedFrame);
     inOverlay = true;
     inCanvasDraw = true;
     
     // Set default drawing style for overlay
     strokeEnabled = true;
-    strokeValue = 1;
+    strokeShade = 255;
+    strokeValue = (uint8_t)getMaxLevel();
 }
 
-void TinyScreen::endOverlay() {
-    if (inOverlay) {
+void TinyScreenBase::endOverlay() {
+    if (inOverlay && grayBits) {
+        pushCanvasPlanes();
+        inOverlay = false;
+        inCanvasDraw = false;
+    } else if (inOverlay) {
         // Convert buffer to frame and display
         uint32_t frame[3];
+        STATS_BEGIN(canvasStart);
         canvasBufferToFrame(frame);
+        STATS_END(canvas, canvasStart);
         
         // Apply invert if enabled
         if (invertDisplay) {
@@ -1289,14 +2583,16 @@ void TinyScreen::endOverlay() {
             frame[2] = ~frame[2];
         }
         
-        matrix.loadFrame(frame);
+        pushFrame(frame);
         inOverlay = false;
         inCanvasDraw = false;
     }
 }
 
-void TinyScreen::displayFrame(const uint32_t frame[3]) {
-    matrix.loadFrame(frame);
+void TinyScreenBase::displayFrame(const uint32_t frame[3]) {
+    // The caller may have drawn on the matrix directly, so never skip
+    pushedFrameValid = false;
+    pushFrame(frame);
 }
 
 //==============================================================================
@@ -1316,7 +2612,7 @@ bool CombinedFilmFestival::addFilm(TinyScreen& film) {
 // TinyScreen LED Control Methods (Proposal 2)
 //==============================================================================
 
-void TinyScreen::indexToXY(int index, int& x, int& y) {
+void TinyScreenBase::indexToXY(int index, int& x, int& y) {
     // Matrix is 12 columns x 8 rows = 96 LEDs
     // Index 0 is top-left (0,0), index 95 is bottom-right (11,7)
     index = constrain(index, 0, 95);
@@ -1324,10 +2620,12 @@ void TinyScreen::indexToXY(int index, int& x, int& y) {
     y = index / 12;
 }
 
-void TinyScreen::led(int x, int y, bool state) {
+void TinyScreenBase::led(int x, int y, bool state) {
     if (x < 0 || x >= 12 || y < 0 || y >= 8) return;
     
-    blinkRate[x][y] = 0;  // Direct write cancels blink on this LED
+    int slot = findBlink(y * 12 + x);
+    if (slot >= 0) removeBlink(slot);  // Direct write cancels blink on this LED
+    releaseFromGroups(y * 12 + x);
     ledBuffer[x][y] = state ? 1 : 0;
     ledBufferDirty = true;
     if (autoShow) {
@@ -1335,27 +2633,31 @@ void TinyScreen::led(int x, int y, bool state) {
     }
 }
 
-void TinyScreen::led(int ledNum, bool state) {
+void TinyScreenBase::led(int ledNum, bool state) {
     int x, y;
     indexToXY(ledNum, x, y);
     led(x, y, state);
 }
 
-bool TinyScreen::getLed(int x, int y) {
+bool TinyScreenBase::getLed(int x, int y) {
     if (x < 0 || x >= 12 || y < 0 || y >= 8) return false;
+    int bitIndex = y * 12 + x;
+    if (groupFrame[bitIndex / 32] & (1UL << (31 - bitIndex % 32))) return true;
     return ledBuffer[x][y] != 0;
 }
 
-bool TinyScreen::getLed(int ledNum) {
+bool TinyScreenBase::getLed(int ledNum) {
     int x, y;
     indexToXY(ledNum, x, y);
     return getLed(x, y);
 }
 
-void TinyScreen::toggle(int x, int y) {
+void TinyScreenBase::toggle(int x, int y) {
     if (x < 0 || x >= 12 || y < 0 || y >= 8) return;
     
-    blinkRate[x][y] = 0;  // Manual toggle cancels blink on this LED
+    int slot = findBlink(y * 12 + x);
+    if (slot >= 0) removeBlink(slot);  // Manual toggle cancels blink on this LED
+    releaseFromGroups(y * 12 + x);
     ledBuffer[x][y] = ledBuffer[x][y] ? 0 : 1;
     ledBufferDirty = true;
     if (autoShow) {
@@ -1363,28 +2665,30 @@ void TinyScreen::toggle(int x, int y) {
     }
 }
 
-void TinyScreen::toggle(int ledNum) {
+void TinyScreenBase::toggle(int ledNum) {
     int x, y;
     indexToXY(ledNum, x, y);
     toggle(x, y);
 }
 
-void TinyScreen::clearLeds() {
+void TinyScreenBase::clearLeds() {
     for (int x = 0; x < 12; x++) {
         for (int y = 0; y < 8; y++) {
             ledBuffer[x][y] = 0;
-            blinkRate[x][y] = 0;
-            lastBlinkTime[x][y] = 0;
         }
     }
+    noBlink();
     ledBufferDirty = true;
     if (autoShow) {
         show();
     }
 }
 
-void TinyScreen::show() {
-    if (!ledBufferDirty) return;
+void TinyScreenBase::show() {
+    if (!ledBufferDirty) {
+        STATS_COUNT(framesSkipped);
+        return;
+    }
     
     // Convert buffer to frame format and display
     // The LED matrix uses 3 x 32-bit words to store 12x8 = 96 bits
@@ -1401,7 +2705,12 @@ void TinyScreen::show() {
         }
     }
     
-    matrix.loadFrame(frame);
+    // Blink groups own their LEDs, so their lit members just OR in
+    frame[0] |= groupFrame[0];
+    frame[1] |= groupFrame[1];
+    frame[2] |= groupFrame[2];
+    
+    pushFrame(frame);
     ledBufferDirty = false;
 }
 
@@ -1409,30 +2718,48 @@ void TinyScreen::show() {
 // Blink Control Methods
 //==============================================================================
 
-void TinyScreen::blink(int x, int y, unsigned long rateMs) {
-    if (x < 0 || x >= 12 || y < 0 || y >= 8) return;
-    if (rateMs == 0) { noBlink(x, y); return; }
+bool TinyScreenBase::blink(int x, int y, unsigned long rateMs) {
+    if (x < 0 || x >= 12 || y < 0 || y >= 8) return false;
+    if (rateMs == 0) { noBlink(x, y); return true; }
+    
+    int ledNum = y * 12 + x;
+    releaseFromGroups(ledNum);
+    int slot = findBlink(ledNum);
+    if (slot >= 0) {
+        removeBlink(slot);  // Restart with the new rate
+    } else if (blinkCount >= blinkCapacity) {
+        return false;
+    }
+    if (rateMs > 0xFFFF) rateMs = 0xFFFF;   // Longest interval a BlinkTimer holds
+    
+    BlinkTimer timer;
+    timer.due = millis() + rateMs;
+    timer.rate = (uint16_t)rateMs;
+    timer.led = (uint8_t)ledNum;
+    slot = blinkCount++;
+    placeBlink(slot, timer);
+    siftBlinkUp(slot);
     
-    blinkRate[x][y] = rateMs;
-    lastBlinkTime[x][y] = millis();
     ledBuffer[x][y] = 1;      // Start in ON state
     ledBufferDirty = true;
     if (autoShow) {
         show();
     }
+    return true;
 }
 
-void TinyScreen::blink(int ledNum, unsigned long rateMs) {
+bool TinyScreenBase::blink(int ledNum, unsigned long rateMs) {
     int x, y;
     indexToXY(ledNum, x, y);
-    blink(x, y, rateMs);
+    return blink(x, y, rateMs);
 }
 
-void TinyScreen::noBlink(int x, int y) {
+void TinyScreenBase::noBlink(int x, int y) {
     if (x < 0 || x >= 12 || y < 0 || y >= 8) return;
     
-    blinkRate[x][y] = 0;
-    lastBlinkTime[x][y] = 0;
+    int slot = findBlink(y * 12 + x);
+    if (slot >= 0) removeBlink(slot);
+    releaseFromGroups(y * 12 + x);
     ledBuffer[x][y] = 0;      // Turn LED off when blinking stops
     ledBufferDirty = true;
     if (autoShow) {
@@ -1440,37 +2767,155 @@ void TinyScreen::noBlink(int x, int y) {
     }
 }
 
-void TinyScreen::noBlink(int ledNum) {
+void TinyScreenBase::noBlink(int ledNum) {
     int x, y;
     indexToXY(ledNum, x, y);
     noBlink(x, y);
 }
 
-void TinyScreen::noBlink() {
-    for (int x = 0; x < 12; x++) {
-        for (int y = 0; y < 8; y++) {
-            blinkRate[x][y] = 0;
-            lastBlinkTime[x][y] = 0;
-        }
+void TinyScreenBase::noBlink() {
+    for (int i = 0; i < blinkCount; i++) {
+        blinkSlot[blinks[i].led] = NO_BLINK_SLOT;
     }
+    blinkCount = 0;
     // Don't change ledBuffer — non-blinking LEDs keep their state
+    for (int g = 0; g < MAX_BLINK_GROUPS; g++) {
+        blinkGroups[g].mask[0] = 0;
+        blinkGroups[g].mask[1] = 0;
+        blinkGroups[g].mask[2] = 0;
+    }
+    // Group LEDs also stay as they are, now owned by ledBuffer
+    for (int b = 0; b < 96; b++) {
+        if (groupFrame[b / 32] & (1UL << (31 - b % 32))) ledBuffer[b % 12][b / 12] = 1;
+    }
+    groupFrame[0] = 0;
+    groupFrame[1] = 0;
+    groupFrame[2] = 0;
 }
 
-void TinyScreen::updateBlinks() {
-    unsigned long now = millis();
-    bool anyChanged = false;
+// Blink every LED in mask at rateMs. LEDs join the group already blinking at
+// that rate (and its phase). A new group starts ON now, or with phaseLock
+// toggles on multiples of rateMs since startup so separate groups stay in step.
+bool TinyScreenBase::blinkMask(const uint32_t mask[3], unsigned long rateMs, bool phaseLock) {
+    if (rateMs == 0) { noBlinkMask(mask); return true; }
     
-    for (int x = 0; x < 12; x++) {
-        for (int y = 0; y < 8; y++) {
-            if (blinkRate[x][y] == 0) continue;  // Not blinking
-            
-            if (now - lastBlinkTime[x][y] >= blinkRate[x][y]) {
-                lastBlinkTime[x][y] = now;
-                ledBuffer[x][y] = ledBuffer[x][y] ? 0 : 1;
-                anyChanged = true;
-            }
+    BlinkGroup* group = nullptr;
+    BlinkGroup* unused = nullptr;
+    for (int g = 0; g < MAX_BLINK_GROUPS; g++) {
+        BlinkGroup& candidate = blinkGroups[g];
+        bool empty = (candidate.mask[0] | candidate.mask[1] | candidate.mask[2]) == 0;
+        if (!empty && candidate.rate == rateMs) { group = &candidate; break; }
+        if (empty && unused == nullptr) unused = &candidate;
+    }
+    if (group == nullptr) {
+        if (unused == nullptr) return false;
+        group = unused;
+        unsigned long now = millis();
+        group->rate = rateMs;
+        if (phaseLock) {
+            unsigned long periods = now / rateMs;
+            group->lit = (periods & 1) == 0;
+            group->due = (periods + 1) * rateMs;
+        } else {
+            group->lit = true;
+            group->due = now + rateMs;
+        }
+    }
+    
+    // Take the LEDs away from per-LED blinkers and other groups
+    removeBlinksIn(mask);
+    for (int g = 0; g < MAX_BLINK_GROUPS; g++) {
+        BlinkGroup& other = blinkGroups[g];
+        if (&other == group) continue;
+        for (int w = 0; w < 3; w++) {
+            other.mask[w] &= ~mask[w];
+        }
+    }
+    for (int w = 0; w < 3; w++) {
+        group->mask[w] |= mask[w];
+        groupFrame[w] &= ~mask[w];
+        if (group->lit) groupFrame[w] |= mask[w];
+    }
+    for (int b = 0; b < 96; b++) {
+        if (mask[b / 32] & (1UL << (31 - b % 32))) ledBuffer[b % 12][b / 12] = 0;
+    }
+    
+    ledBufferDirty = true;
+    if (autoShow) {
+        show();
+    }
+    return true;
+}
+
+void TinyScreenBase::noBlinkMask(const uint32_t mask[3]) {
+    for (int g = 0; g < MAX_BLINK_GROUPS; g++) {
+        for (int w = 0; w < 3; w++) {
+            blinkGroups[g].mask[w] &= ~mask[w];
+        }
+    }
+    for (int w = 0; w < 3; w++) {
+        groupFrame[w] &= ~mask[w];
+    }
+    removeBlinksIn(mask);
+    for (int b = 0; b < 96; b++) {
+        if (mask[b / 32] & (1UL << (31 - b % 32))) ledBuffer[b % 12][b / 12] = 0;
+    }
+    
+    ledBufferDirty = true;
+    if (autoShow) {
+        show();
+    }
+}
+
+void TinyScreenBase::releaseFromGroups(int ledNum) {
+    int w = ledNum / 32;
+    uint32_t bit = 1UL << (31 - ledNum % 32);
+    for (int g = 0; g < MAX_BLINK_GROUPS; g++) {
+        if (blinkGroups[g].mask[w] & bit) {
+            blinkGroups[g].mask[w] &= ~bit;
+            ledBuffer[ledNum % 12][ledNum / 12] = (groupFrame[w] & bit) ? 1 : 0;
+            groupFrame[w] &= ~bit;
+            return;
+        }
+    }
+}
+
+// Toggle each due group with one XOR. Missed toggles are counted, not
+// dropped, so a group keeps its phase even if updateBlinks() runs late.
+bool TinyScreenBase::updateBlinkGroups(unsigned long now) {
+    bool toggled = false;
+    for (int g = 0; g < MAX_BLINK_GROUPS; g++) {
+        BlinkGroup& group = blinkGroups[g];
+        if ((group.mask[0] | group.mask[1] | group.mask[2]) == 0) continue;
+        if ((long)(now - group.due) < 0) continue;
+        
+        unsigned long toggles = (now - group.due) / group.rate + 1;
+        group.due += toggles * group.rate;
+        if (toggles & 1) {
+            group.lit = !group.lit;
+            groupFrame[0] ^= group.mask[0];
+            groupFrame[1] ^= group.mask[1];
+            groupFrame[2] ^= group.mask[2];
+            toggled = true;
         }
     }
+    return toggled;
+}
+
+// Toggle every blinker that is due; cost grows with the number due, not 96
+void TinyScreenBase::updateBlinks() {
+    unsigned long now = millis();
+    bool anyChanged = updateBlinkGroups(now);
+    
+    while (blinkCount > 0 && (int32_t)((uint32_t)now - blinks[0].due) >= 0) {
+        int x = blinks[0].led % 12;
+        int y = blinks[0].led / 12;
+        ledBuffer[x][y] = ledBuffer[x][y] ? 0 : 1;
+        anyChanged = true;
+        
+        blinks[0].due = (uint32_t)now + blinks[0].rate;
+        siftBlinkDown(0);
+    }
     
     if (anyChanged) {
         ledBufferDirty = true;
@@ -1480,7 +2925,67 @@ void TinyScreen::updateBlinks() {
     }
 }
 
-void TinyScreen::setAutoShow(bool enabled) {
+//--- Blink heap (ordered on due time, wrap-safe) ---
+// blinkSlot[] follows every move, so finding an LED's blinker is O(1)
+
+void TinyScreenBase::placeBlink(int slot, const BlinkTimer& timer) {
+    blinks[slot] = timer;
+    blinkSlot[timer.led] = (uint8_t)slot;
+}
+
+void TinyScreenBase::removeBlink(int slot) {
+    blinkSlot[blinks[slot].led] = NO_BLINK_SLOT;
+    blinkCount--;
+    if (slot == blinkCount) return;
+    placeBlink(slot, blinks[blinkCount]);
+    siftBlinkUp(slot);
+    siftBlinkDown(slot);
+}
+
+// Drop every blinker in the mask: compact in one pass, then rebuild the heap.
+// (removeBlink() in a loop can sift an unvisited entry into a visited slot.)
+void TinyScreenBase::removeBlinksIn(const uint32_t mask[3]) {
+    int kept = 0;
+    for (int i = 0; i < blinkCount; i++) {
+        int b = blinks[i].led;
+        if (mask[b / 32] & (1UL << (31 - b % 32))) {
+            blinkSlot[b] = NO_BLINK_SLOT;
+            continue;
+        }
+        placeBlink(kept++, blinks[i]);
+    }
+    if (kept == blinkCount) return;
+    blinkCount = (uint8_t)kept;
+    for (int slot = blinkCount / 2 - 1; slot >= 0; slot--) {
+        siftBlinkDown(slot);
+    }
+}
+
+void TinyScreenBase::siftBlinkUp(int slot) {
+    BlinkTimer moving = blinks[slot];
+    while (slot > 0) {
+        int parent = (slot - 1) / 2;
+        if ((int32_t)(moving.due - blinks[parent].due) >= 0) break;
+        placeBlink(slot, blinks[parent]);
+        slot = parent;
+    }
+    placeBlink(slot, moving);
+}
+
+void TinyScreenBase::siftBlinkDown(int slot) {
+    BlinkTimer moving = blinks[slot];
+    for (;;) {
+        int child = slot * 2 + 1;
+        if (child >= blinkCount) break;
+        if (child + 1 < blinkCount && (int32_t)(blinks[child + 1].due - blinks[child].due) < 0) child++;
+        if ((int32_t)(blinks[child].due - moving.due) >= 0) break;
+        placeBlink(slot, blinks[child]);
+        slot = child;
+    }
+    placeBlink(slot, moving);
+}
+
+void TinyScreenBase::setAutoShow(bool enabled) {
     autoShow = enabled;
 }
 
@@ -1488,12 +2993,14 @@ void TinyScreen::setAutoShow(bool enabled) {
 // Standalone LED Functions (Proposal 1)
 //==============================================================================
 
-// Internal default TinyScreen instance for standalone functions
-static TinyScreen* _defaultScreen = nullptr;
+// Internal default screen for standalone functions; ledBlink() may be called
+// on every LED (BlinkFrame), so it has a blinker for each
+using LedScreen = TinyScreenT<MAX_LAYERS, 96>;
+static LedScreen* _defaultScreen = nullptr;
 
-static TinyScreen& getDefaultScreen() {
+static LedScreen& getDefaultScreen() {
     if (_defaultScreen == nullptr) {
-        _defaultScreen = new TinyScreen();
+        _defaultScreen = new LedScreen();
     }
     return *_defaultScreen;
 }
@@ -1554,11 +3061,19 @@ void ledNoBlink() {
     getDefaultScreen().noBlink();
 }
 
+void ledBlinkMask(const uint32_t mask[3], unsigned long rateMs, bool phaseLock) {
+    getDefaultScreen().blinkMask(mask, rateMs, phaseLock);
+}
+
+void ledNoBlinkMask(const uint32_t mask[3]) {
+    getDefaultScreen().noBlinkMask(mask);
+}
+
 void ledUpdate() {
     getDefaultScreen().updateBlinks();
 }
 
-TinyScreen& getLedMatrix() {
+TinyScreenBase& getLedMatrix() {
     return getDefaultScreen();
 }
 
@@ -43,8 +43,36 @@
 // for drawing methods to work properly
 #include "ArduinoGraphics.h"
 #include "Arduino_LED_Matrix.h"
+#include "FspTimer.h"
 
-#define MAX_LAYERS 5  // Maximum animation layers
+#define MAX_LAYERS 5  // Animation layers in a plain TinyScreen (use TinyScreenT<N> for more/fewer)
+#define MAX_BLINKS 32  // LEDs blinking at once in a plain TinyScreen (use TinyScreenT<N, 96> to blink every LED)
+#define MAX_BLINK_GROUPS 4  // Distinct blinkMask() rates at once
+#define MAX_QUEUE 0  // Animations waiting per layer in a plain TinyScreen: none (use TinyScreenT<N, B, Q> to queue)
+
+// Grayscale: bit-planes, each shown for a power-of-two number of ticks. A tick
+// is one full scan of the matrix (the core's LED interrupt lights one of the
+// 96 LEDs every 100 us), so every LED sees whole planes. A cycle takes
+// 2^bits - 1 ticks: 28.8 ms (35 Hz) at 2 bits, but 67 ms (15 Hz) at 3 and
+// 144 ms (7 Hz) at 4, which flicker, so 2 bits is the limit. Raise
+// MAX_GRAY_BITS (up to 4) only together with a shorter -DGRAY_TICK_US.
+#ifndef MAX_GRAY_BITS
+#define MAX_GRAY_BITS 2
+#endif
+#ifndef GRAY_TICK_US
+#define GRAY_TICK_US 9600
+#endif
+static_assert(MAX_GRAY_BITS >= 2 && MAX_GRAY_BITS <= 4, "MAX_GRAY_BITS must be 2 to 4");
+
+// Longest wait nextDeadline() reports when nothing is scheduled (~24.8 days),
+// the furthest ahead a millis() time can be and still compare correctly
+#define NO_DEADLINE_MS 0x7FFFFFFFUL
+
+// Frame statistics (per-stage timing). Off by default and compiled out
+// entirely; enable with a build flag (-DTINYSCREEN_STATS=1) or by editing here.
+#ifndef TINYSCREEN_STATS
+#define TINYSCREEN_STATS 0
+#endif
 
 // Forward declarations
 class Animation;
@@ -82,31 +110,327 @@ enum AnimationState {
     COMPLETED
 };
 
+//------------------------------------------------------------------------------
+// BlendMode - How a layer combines with the layers below it
+//------------------------------------------------------------------------------
+enum BlendMode {
+    BLEND_OR,          // Add lit pixels (default)
+    BLEND_AND,         // Keep only pixels lit in both
+    BLEND_XOR,         // Flip pixels under lit pixels
+    BLEND_REPLACE,     // Replace everything inside the layer's mask
+    BLEND_SUBTRACT     // Cut lit pixels out of the layers below
+};
+
+//------------------------------------------------------------------------------
+// TimingMode - What a layer does when update() is called late
+//------------------------------------------------------------------------------
+enum TimingMode {
+    TIMING_RELATIVE,   // Each frame lasts its time from when it was shown; stalls delay playback (default)
+    TIMING_CATCH_UP,   // Schedule stays anchored; one frame per update() until back on time
+    TIMING_DROP        // Schedule stays anchored; jump straight to the frame due now
+};
+
+//------------------------------------------------------------------------------
+// BlinkTimer - One blinking LED, kept in a min-heap ordered by due time
+//------------------------------------------------------------------------------
+struct BlinkTimer {
+    uint32_t due;                      // millis() of the next toggle
+    uint16_t rate;                     // Toggle interval in ms (1-65535)
+    uint8_t led;                       // Linear LED index (y * 12 + x)
+};
+
+#define NO_BLINK_SLOT 0xFF  // blinkSlot[] entry of an LED that isn't blinking
+
+//------------------------------------------------------------------------------
+// BlinkGroup - LEDs that share one blink rate, toggled together with one XOR
+//------------------------------------------------------------------------------
+struct BlinkGroup {
+    uint32_t mask[3];                  // Member LEDs (frame layout); all zero = unused
+    unsigned long rate;                // Toggle interval in ms
+    unsigned long due;                 // millis() of the next toggle
+    bool lit;                          // Members currently ON
+};
+
+#if TINYSCREEN_STATS
+//------------------------------------------------------------------------------
+// Frame Statistics - min/avg/max microseconds per pipeline stage
+//------------------------------------------------------------------------------
+struct StageTiming {
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t totalUs;
+    uint32_t count;
+
+    uint32_t avgUs() const { return count ? totalUs / count : 0; }
+
+    void record(uint32_t us) {
+        if (count == 0 || us < minUs) minUs = us;
+        if (us > maxUs) maxUs = us;
+        totalUs += us;
+        count++;
+    }
+
+    void reset() { minUs = 0; maxUs = 0; totalUs = 0; count = 0; }
+};
+
+struct TinyScreenStats {
+    StageTiming layerAdvance;          // updateFrame() on every layer
+    StageTiming compositing;           // Combining layer frames (+ invert)
+    StageTiming canvas;                // Canvas buffer to frame (endDraw/endOverlay)
+    StageTiming push;                  // matrix.loadFrame()
+    uint32_t framesPushed;             // Frames sent to the matrix
+    uint32_t framesSkipped;            // Pushes skipped because nothing changed
+
+    void reset() {
+        layerAdvance.reset();
+        compositing.reset();
+        canvas.reset();
+        push.reset();
+        framesPushed = 0;
+        framesSkipped = 0;
+    }
+};
+#endif
+
+//------------------------------------------------------------------------------
+// Packed Animations - Compressed frame data (made by extras/host/tools/tfpack)
+//------------------------------------------------------------------------------
+//
+//   [0]    PACKED_FORMAT
+//   [1]    flags (PACKED_UNIFORM_TIMING, PACKED_WIDE_TIMING)
+//   [2..3] frame count (little-endian, as are all fields)
+//   [4]    keyframe interval K (1-255)
+//   [5]    reserved, 0
+//   timings:   1 entry if uniform, else one per frame; 16-bit, or 32-bit if wide
+//   keyframes: 16-bit offset into the records for frames 0, K, 2K, ...
+//   records:   one per frame, the 12 frame bytes XOR the previous frame
+//              (XOR zero at keyframes). Tokens: 0x00-0x7F = n+1 literal bytes
+//              follow; 0x80-0xFF = n+1 unchanged bytes.
+//
+// Stepping forward decodes one record. Jumping or stepping backward decodes
+// at most K records, starting from the nearest keyframe.
+//
+#define PACKED_FORMAT 1
+#define PACKED_HEADER_SIZE 6
+#define PACKED_UNIFORM_TIMING 0x01
+#define PACKED_WIDE_TIMING 0x02
+
+//------------------------------------------------------------------------------
+// FrameStep - One entry of a pooled animation: which pool frame, for how long
+//------------------------------------------------------------------------------
+// A pool (const uint32_t name[][3]) holds each distinct frame once. Any
+// number of animations can share it, each listing its frames as steps:
+//
+//   const uint32_t showFrames[][3] = { {...}, {...}, {...} };
+//   const FrameStep idleSteps[] = { {0, 300}, {1, 150}, {2, 150}, {1, 150} };
+//   const Animation idle(showFrames, idleSteps);
+//
+struct FrameStep {
+    uint16_t frame;                    // Index into the pool
+    uint16_t ms;                       // Duration, 1-65535 ms
+};
+
+//------------------------------------------------------------------------------
+// AnimationDescriptor - Frame table plus timing facts worked out at compile time
+//------------------------------------------------------------------------------
+// The frame table must be constexpr (change `const` to `constexpr` in the
+// exported header):
+//
+//   constexpr uint32_t idle[][4] = { ... };
+//   DESCRIBE_ANIMATION(idleInfo, idle);   // compile error if a frame time is 0
+//   screen.play(idleInfo, LOOP);
+//
+// The descriptor is static, so it outlives the call even when described inside
+// a function such as setup() - the playing layer keeps pointers into it.
+//
+struct AnimationTiming {
+    uint32_t totalMs;                  // One pass through every frame
+    uint32_t minFrameMs;
+    uint32_t maxFrameMs;
+    bool narrowTiming;                 // Every frame time fits in 16 bits (high bits of [3] unused)
+};
+
+template<size_t N>
+struct AnimationDescriptor {
+    const uint32_t (*frames)[4];
+    AnimationTiming timing;
+    uint32_t startMs[N + 1];           // When each frame starts in one pass; startMs[N] = totalMs
+};
+
+template<typename Frame, size_t N>
+constexpr bool animationTimesValid(const Frame (&frames)[N]) {
+    if constexpr (sizeof(Frame) != 4 * sizeof(uint32_t)) {
+        return false;
+    } else {
+        for (size_t i = 0; i < N; i++) {
+            if (frames[i][3] == 0) return false;
+        }
+        return true;
+    }
+}
+
+template<size_t N>
+constexpr AnimationDescriptor<N> describeAnimation(const uint32_t (&frames)[N][4]) {
+    AnimationDescriptor<N> d = {frames, {0, frames[0][3], frames[0][3], true}, {}};
+    for (size_t i = 0; i < N; i++) {
+        uint32_t ms = frames[i][3];
+        d.startMs[i] = d.timing.totalMs;
+        d.timing.totalMs += ms;
+        if (ms < d.timing.minFrameMs) d.timing.minFrameMs = ms;
+        if (ms > d.timing.maxFrameMs) d.timing.maxFrameMs = ms;
+        if (ms > 0xFFFF) d.timing.narrowTiming = false;
+    }
+    d.startMs[N] = d.timing.totalMs;
+    return d;
+}
+
+#define DESCRIBE_ANIMATION(name, frameTable) \
+    static_assert(sizeof((frameTable)[0]) == 4 * sizeof(uint32_t), \
+                  #frameTable " must be a uint32_t[N][4] frame table"); \
+    static_assert(animationTimesValid(frameTable), #frameTable " has a frame time of 0 ms"); \
+    static constexpr auto name = describeAnimation(frameTable)
+
 //------------------------------------------------------------------------------
 // Animation - Wrapper for LED Matrix Editor frame data
 //------------------------------------------------------------------------------
 class Animation {
 private:
-    const uint32_t (*frames)[4];
-    int frameCount;
+    enum Kind : uint8_t { NONE, TABLE, DESCRIBED, PACKED, POOLED };
+
+    struct DescribedFrames {
+        const uint32_t (*frames)[4];
+        const uint32_t* startMs;       // Descriptor's prefix sums of frame times
+    };
+    struct PooledFrames {
+        const uint32_t (*pool)[3];     // Frames, indexed by sequence
+        const FrameStep* sequence;
+    };
+
+    // An animation has exactly one source of frames, so they share storage
+    union Source {
+        const uint32_t (*frames)[4];   // TABLE
+        DescribedFrames described;     // DESCRIBED
+        const uint8_t* packed;         // PACKED
+        PooledFrames pooled;           // POOLED
+
+        constexpr Source() : frames(nullptr) {}
+        constexpr Source(const uint32_t (*table)[4]) : frames(table) {}
+        constexpr Source(DescribedFrames d) : described(d) {}
+        constexpr Source(const uint8_t* data) : packed(data) {}
+        constexpr Source(PooledFrames p) : pooled(p) {}
+    };
+
+    Source source;
+    uint16_t frameCount;
+    Kind kind;
+
+    static int packedFrameCount(const uint8_t* data, size_t size) {
+        if (size < PACKED_HEADER_SIZE || data[0] != PACKED_FORMAT || data[4] == 0) return 0;
+        return data[2] | (data[3] << 8);
+    }
+
+    // Every step must name a pool frame and last at least 1 ms
+    static constexpr int sequenceFrameCount(const FrameStep* steps, size_t count, size_t poolSize) {
+        for (size_t i = 0; i < count; i++) {
+            if (steps[i].frame >= poolSize || steps[i].ms == 0) return 0;
+        }
+        return (int)count;
+    }
 
 public:
-    Animation() : frames(nullptr), frameCount(0) {}
+    constexpr Animation() : source(), frameCount(0), kind(NONE) {}
     
     template<size_t N>
-    Animation(const uint32_t (&frameArray)[N][4]) : frames(frameArray), frameCount(N) {}
+    constexpr Animation(const uint32_t (&frameArray)[N][4]) :
+        source(frameArray), frameCount(N), kind(TABLE) {}
+    
+    // Validated at compile time by DESCRIBE_ANIMATION
+    template<size_t N>
+    constexpr Animation(const AnimationDescriptor<N>& descriptor) :
+        source(DescribedFrames{descriptor.frames, descriptor.startMs}), frameCount(N), kind(DESCRIBED) {}
+    
+    template<size_t N>
+    Animation(const uint8_t (&packedData)[N]) :
+        source(packedData), frameCount((uint16_t)packedFrameCount(packedData, N)), kind(PACKED) {}
+    
+    // Packed data reached through a pointer (the buffer must outlive playback)
+    Animation(const uint8_t* packedData, size_t size) :
+        source(packedData), frameCount((uint16_t)packedFrameCount(packedData, size)), kind(PACKED) {}
+    
+    // Pooled frames; constexpr so a const Animation built from them stays in flash
+    template<size_t P, size_t N>
+    constexpr Animation(const uint32_t (&framePool)[P][3], const FrameStep (&steps)[N]) :
+        source(PooledFrames{framePool, steps}), frameCount((uint16_t)sequenceFrameCount(steps, N, P)),
+        kind(POOLED) {}
     
     template<size_t N>
     Animation& operator=(const uint32_t (&frameArray)[N][4]) {
-        frames = frameArray;
-        frameCount = N;
+        *this = Animation(frameArray);
         return *this;
     }
 
-    const uint32_t (*getFrames() const)[4] { return frames; }
+    template<size_t N>
+    Animation& operator=(const uint8_t (&packedData)[N]) {
+        *this = Animation(packedData);
+        return *this;
+    }
+
+    const uint32_t (*getFrames() const)[4] {
+        return kind == TABLE ? source.frames : kind == DESCRIBED ? source.described.frames : nullptr;
+    }
+    const uint8_t* getPacked() const { return kind == PACKED ? source.packed : nullptr; }
+    const uint32_t (*getPool() const)[3] { return kind == POOLED ? source.pooled.pool : nullptr; }
+    const FrameStep* getSequence() const { return kind == POOLED ? source.pooled.sequence : nullptr; }
+    const uint32_t* getStartTimes() const { return kind == DESCRIBED ? source.described.startMs : nullptr; }
+    bool isPacked() const { return kind == PACKED; }
+    bool isPooled() const { return kind == POOLED; }
     int getFrameCount() const { return frameCount; }
 };
 
+//------------------------------------------------------------------------------
+// Timeline - Master clock that layers can follow in lockstep
+//------------------------------------------------------------------------------
+// A following layer shows the frame for (timeline time - when it started),
+// so layers started together never drift apart, and pausing, seeking or
+// changing the rate of the timeline moves all of them at once.
+class Timeline {
+private:
+    unsigned long originMs;            // millis() when the timeline read originTime
+    unsigned long originTime;
+    uint32_t rateScale;                // Q16 timeline ms per real ms
+    uint32_t edits;                    // Bumped on pause/resume/seek/rate so layers resync
+    bool paused;
+
+    void rebase(unsigned long now);    // Restart the origin at now, keeping the time
+
+public:
+    Timeline();
+
+    unsigned long time() const { return timeAt(millis()); }
+    unsigned long timeAt(unsigned long now) const;
+    unsigned long msUntil(unsigned long timelineMs, unsigned long now) const;  // Real ms until the timeline reaches it
+
+    void pause();
+    void resume();
+    void seek(unsigned long ms);       // Jump to a timeline time
+    void setRate(float rate);          // 1.0 = real time, 0.5 = half speed (negative = 0)
+    float getRate() const { return rateScale / 65536.0f; }
+    bool isPaused() const { return paused; }
+    uint32_t getEdits() const { return edits; }
+};
+
+//------------------------------------------------------------------------------
+// QueuedAnimation - One playlist entry waiting for its layer to finish
+//------------------------------------------------------------------------------
+// Slots with no frames mark the end of a layer's queue.
+struct QueuedAnimation {
+    Animation animation;
+    uint16_t loops;                    // Passes to play (boomerang: out and back); 0 = until more is queued
+    int16_t startFrame;                // 1-based range, 0/0 = whole animation
+    int16_t endFrame;
+    uint8_t mode;                      // PlayMode
+};
+
 //------------------------------------------------------------------------------
 // AnimationLayer - Internal class for managing one animation track
 //------------------------------------------------------------------------------
@@ -114,7 +438,6 @@ class AnimationLayer {
 private:
     bool isCustomSpeed;
     int customSpeedInterval;
-    uint32_t* originalTimings;
     int frameCount;
     int currentFrameIndex;
     int startFrameIndex;
@@ -125,24 +448,88 @@ private:
     bool defaultPlayingBackward;
     bool speedDirectionOverride;
     bool useSpeedMultiplier;
-    float speedMultiplier;
+    uint32_t speedScale;               // Q16 frame-time scale, 65536 / multiplier (set by setSpeed)
+    uint32_t currentInterval;          // Current frame's duration after speed changes
     const uint32_t (*currentAnimation)[4];
+    const uint8_t* packedData;         // Packed stream when playing a packed Animation
+    const uint32_t (*framePool)[3];    // Pool and steps when playing a pooled Animation
+    const FrameStep* frameSequence;
+    const uint32_t* frameStartMs;      // Descriptor prefix sums, nullptr = work them out
     unsigned long lastUpdateTime;
     PlayMode currentMode;
     AnimationState currentState;
+    TimingMode timingMode;
 
     int8_t offsetX;
     int8_t offsetY;
     
+    // Last offset frame built by getFrame(), reused until the frame or offset changes
+    mutable uint32_t positionedFrame[3];
+    mutable int positionedFrameIndex;  // Frame index it was built from, -1 = none
+    
+    // Compositing
+    BlendMode blendMode;
+    int8_t zOrder;                     // Lower draws first (further back)
+    const uint32_t* maskFrame;         // BLEND_REPLACE mask, nullptr = whole animation area
+    uint8_t brightness;                // 0-255, used in grayscale mode
+    mutable uint32_t positionedMask[3];
+    mutable bool positionedMaskValid;
+    
+    // Timeline following: the frame comes from timeline time, not from lastUpdateTime
+    const Timeline* timeline;          // nullptr = free-running
+    unsigned long timelineStart;       // Timeline time the animation started at
+    unsigned long frameEndsAt;         // Timeline time the current frame ends
+    uint32_t timelineEdits;            // Timeline edits already applied
+    uint32_t rangeMs;                  // One pass through startFrame..endFrame
+    
+    // Loop counting: the layer completes after loopLimit loops (0 = never)
+    uint32_t loopLimit;
+    uint32_t loopsDone;
+    bool finishingLoop;                // loopLimit was set by finishLoop()
+    
+    // Packed playback: the frame at decodedIndex, rebuilt from XOR records
+    mutable uint32_t decodedFrame[3];
+    mutable int decodedIndex;          // -1 = nothing decoded yet
+    mutable uint16_t decodedPos;       // Offset of the record after decodedIndex
+    
     void cleanup();
-    void copyTimings(const uint32_t frames[][4], int numFrames);
-    bool isValidAnimation() const { return currentAnimation != nullptr && frameCount > 0; }
+    bool isValidAnimation() const {
+        return (currentAnimation != nullptr || packedData != nullptr || frameSequence != nullptr) && frameCount > 0;
+    }
+    // Authored frame duration, read straight from the animation's frame table.
+    // Plain tables may hold 0 ms frames; they count as 1 ms so a pass always takes time.
+    uint32_t frameTime(int index) const {
+        uint32_t ms = frameSequence ? frameSequence[index].ms
+                    : packedData ? packedFrameTime(index) : currentAnimation[index][3];
+        return ms ? ms : 1;
+    }
+    uint32_t packedFrameTime(int index) const;
+    const uint32_t* frameWords() const;   // Current frame's 3 words
+    void decodePacked(int index) const;
+    uint32_t frameInterval() const { return currentInterval; }
+    void refreshInterval();            // Recompute currentInterval after a frame or speed change
+    void stepFrame();                  // Move one frame in the play direction (may complete)
+    uint32_t sumFrameTimes(int first, int last) const;  // Authored ms of frames first..last (0 if empty)
+    uint32_t rangeDuration() const { return sumFrameTimes(startFrameIndex, endFrameIndex); }
+    uint32_t passTimeOf(int index) const;  // Ms from the start of a pass to frame index
+    int frameAtTime(int first, int last, uint32_t ms, uint32_t& into) const;  // Forward; into = ms into that frame
+    int frameInPass(int first, int last, uint32_t total, bool backward, uint32_t ms, uint32_t& into) const;
+    void landOnFrame(uint32_t into);   // Finish a seek to currentFrameIndex
+    bool usesFixedInterval() const { return isCustomSpeed && !useSpeedMultiplier; }
+    bool onLastLoop() const { return loopLimit != 0 && loopsDone + 1 >= loopLimit; }
+    uint32_t loopLength(uint32_t& pass) const;  // Layer ms of one loop; pass = the outward sweep
+    uint32_t toLayerTime(uint32_t timelineMs) const;
+    uint32_t toTimelineTime(uint32_t layerMs) const;
+    uint32_t cycleTimeOf(int index) const;
+    void alignToTimeline(uint32_t intoMs);
+    bool syncToTimeline(unsigned long timelineNow);  // Returns true if the frame or state changed
 
 public:
     AnimationLayer();
-    ~AnimationLayer();
 
     void start(const Animation& animation, PlayMode mode, int startFrame, int endFrame);
+    void startAfter(const Animation& animation, PlayMode mode, int startFrame, int endFrame,
+                    uint32_t loops = 0);   // From the moment the last run completed (loops 0 = mode default)
     void setSpeed(int speedMs);
     void setSpeed(float speedMultiplier);
     void setSpeed(double speedMultiplier);
@@ -151,6 +538,12 @@ public:
     void restoreOriginalSpeed();
     void stop();
     bool updateFrame();  // Returns true if frame updated
+    unsigned long msUntilNextFrame(unsigned long now) const;  // 0 = due now (only while playing)
+    
+    // Seeking within the play range; keeps mode, speed and pause state
+    void seekToFrame(int frameNum);
+    void seekToTime(unsigned long ms);
+    void seekToFraction(float fraction);
     bool getFrame(uint32_t frame[3]) const;  // Get current frame data
 
     // Status
@@ -163,44 +556,115 @@ public:
     
     AnimationState getState() const { return currentState; }
     int getTotalFrames() const { return frameCount; }
+    unsigned long getTotalDuration() const;  // Ms for one pass through every frame, before speed changes
     int getCurrentFrameNum() const { return currentFrameIndex + 1; }
     int getCurrentSpeed() const;
     int getStartFrame() const { return startFrameIndex + 1; }
     int getEndFrame() const { return endFrameIndex + 1; }
     
+    // Loops before the layer completes; a loop is one pass (boomerang: out and back).
+    // start() sets 1 for ONCE and 0 (never) for LOOP and BOOMERANG.
+    void setLoopCount(uint32_t loops) { loopLimit = loops; finishingLoop = false; }
+    uint32_t getLoopCount() const { return loopLimit; }
+    uint32_t getLoopsDone() const { return loopsDone; }
+    void finishLoop();                 // An endless loop completes at the end of the loop in progress
+    void keepLooping();                // Undo finishLoop()
+    
+    // Master clock (nullptr = run on this layer's own timing)
+    void setTimeline(const Timeline* master);
+    const Timeline* getTimeline() const { return timeline; }
+    bool wantsUpdates() const { return currentState == PLAYING || (timeline != nullptr && currentState == COMPLETED); }
+    
+    // Late-update policy
+    void setTimingMode(TimingMode mode) { timingMode = mode; }
+    TimingMode getTimingMode() const { return timingMode; }
+    
     // Position offset
     void setOffset(int x, int y);
     int getOffsetX() const { return offsetX; }
     int getOffsetY() const { return offsetY; }
+    
+    // Compositing
+    void setBlendMode(BlendMode mode) { blendMode = mode; }
+    BlendMode getBlendMode() const { return blendMode; }
+    void setZOrder(int z) { zOrder = (int8_t)z; }
+    int getZOrder() const { return zOrder; }
+    void setMask(const uint32_t mask[3]);   // Frame in animation coordinates, moves with the offset
+    void getMask(uint32_t mask[3]) const;   // Mask positioned on the display
+    void setBrightness(int value) { brightness = (uint8_t)constrain(value, 0, 255); }
+    int getBrightness() const { return brightness; }
+};
+
+//------------------------------------------------------------------------------
+// GrayscaleState - Bit-planes and timer behind setGrayscale() (TinyScreenGray)
+//------------------------------------------------------------------------------
+// Only screens declared with grayscale support carry this, so on/off sketches
+// pay no RAM for planes or a timer object.
+struct GrayscaleState {
+    uint16_t canvasPlanes[MAX_GRAY_BITS][8];   // Canvas levels, bit k of each pixel in plane k
+    uint32_t levelPlanes[MAX_GRAY_BITS][3];    // Last pushed levels, before global brightness
+    uint32_t bamPlanes[2][MAX_GRAY_BITS][3];   // Front (shown by the interrupt) and back buffer
+    volatile uint8_t bamFront;
+    volatile bool bamSwapPending;      // Back buffer holds a newer image; swap at the next cycle
+    uint8_t bamStep;                   // Tick within the cycle, 1 to 2^grayBits - 1
+    bool bamTimerOpen;
+    FspTimer bamTimer;
+
+    GrayscaleState();
+    ~GrayscaleState();                 // Stops and closes the timer: no interrupt outlives the screen
+
+    GrayscaleState(const GrayscaleState&) = delete;
+    GrayscaleState& operator=(const GrayscaleState&) = delete;
 };
 
 //------------------------------------------------------------------------------
-// TinyScreen - The main unified class
+// TinyScreenBase - The main unified class (layer storage lives in TinyScreenT)
 //------------------------------------------------------------------------------
-class TinyScreen {
+class TinyScreenBase {
 private:
     ArduinoLEDMatrix matrix;
-    AnimationLayer layers[MAX_LAYERS];
+    AnimationLayer* layers;            // Storage owned by TinyScreenT<N>
+    uint8_t layerCapacity;
     uint8_t layerCount;
+    uint32_t playingLayers;            // Bit per layer that needs updateFrame()
+    uint32_t visibleLayers;            // Bit per layer with a frame to show (not IDLE)
+    uint8_t* drawOrder;                // Layer indices back to front (storage owned by TinyScreenT<N>)
+    QueuedAnimation* queued;           // queueCapacity slots per layer, next to play first (storage owned by TinyScreenT)
+    uint8_t queueCapacity;
+    bool customOrder;                  // Any z-order set; otherwise draw in index order
+    bool composeDirty;                 // Matrix may not be showing the current layer composite
+    bool layersOnMatrix;               // Last update() push had layers in it (a stop needs one more update)
+    Timeline timeline;                 // Master clock for layers that follow it
     uint32_t combinedFrame[3];
+    uint32_t pushedFrame[3];           // Last frame sent to the matrix
+    bool pushedFrameValid;             // False until first push / after direct matrix use
+    unsigned long skippedPushes;       // Pushes skipped because the frame was unchanged
     bool inOverlay;
     bool autoShow;
     
     // Canvas mode buffering (flicker-free drawing)
-    uint8_t canvasBuffer[8][12];      // [row][col] pixel buffer
+    uint16_t canvasRows[8];            // [row] 12 bits per row, bit 11 = column 0
     bool inCanvasDraw;                 // Currently in beginDraw/endDraw block
     bool strokeEnabled;
     bool fillEnabled;
-    uint8_t strokeValue;               // 1 = ON, 0 = OFF
-    uint8_t fillValue;                 // 1 = ON, 0 = OFF
+    uint8_t strokeValue;               // Level drawn (mono: 1 = ON, 0 = OFF)
+    uint8_t fillValue;
+    uint8_t strokeShade;               // Brightest channel of the stroke color, 0-255
+    uint8_t fillShade;
+    
+    // Grayscale: bit-planes shown by bit-angle modulation from a timer interrupt
+    GrayscaleState* gray;              // Storage owned by TinyScreenT, nullptr = on/off only
+    uint8_t grayBits;                  // Planes per pixel, 0 = monochrome
+    uint8_t brightness;                // Global, 0-255
     
     // Text rendering state
     uint8_t textSize;                  // 1 = normal (3x5), 2 = double (6x10)
     int scrollOffset;                  // Current scroll position
     unsigned long scrollSpeed;         // Ms per pixel
     unsigned long lastScrollTime;      // Last scroll update time
+    bool scrollActive;                 // scrollText() in use (until resetScroll())
     
-    // Display rotation (0, 90, 180, 270 degrees)
+    // Display rotation (0, 90, 180, 270 degrees) - applies to canvas and animations
     uint8_t rotation;                  // 0=0°, 1=90°, 2=180°, 3=270°
     
     // Display invert
@@ -208,12 +672,40 @@ private:
     
     // Internal drawing helpers
     void bufferPoint(int x, int y, uint8_t value);
+    void bufferSpan(int x1, int x2, int y, uint8_t value);   // Horizontal run x1..x2 inclusive
     void bufferLine(int x1, int y1, int x2, int y2);
     void bufferRect(int x, int y, int w, int h);
     void bufferCircle(int cx, int cy, int r);
     void bufferToFrame(uint32_t frame[3]);
     void bufferCharScaled(char c, int x, int y, uint8_t value, int scale);
     void frameToBuffer(const uint32_t frame[3]);  // Load frame into canvas buffer
+    uint8_t shadeToLevel(uint8_t shade) const;    // 0-255 to a level of the current depth
+    
+    // Frame pipeline stages (shared by update() and beginOverlay())
+    void advanceLayers();
+    void composeLayers(uint32_t frame[3]);
+    void pushFrame(const uint32_t frame[3]);
+    void syncLayer(int layer);         // Refresh a layer's playing/visible bits and mark the composite stale
+    void blendLayer(int layer, uint32_t frame[3]);
+    void sortLayers();
+    bool layersDue(unsigned long now) const;
+    bool composeDue() const { return composeDirty && (visibleLayers != 0 || layersOnMatrix); }
+    QueuedAnimation* queueOf(int layer) { return queued + layer * queueCapacity; }
+    const QueuedAnimation* queueOf(int layer) const { return queued + layer * queueCapacity; }
+    bool playQueued(int layer, bool chained);   // Start the layer's next entry; false if none
+    
+    // Grayscale pipeline
+    void composeLevels(uint32_t frame[3], uint32_t planes[][3]);   // composeLayers() plus per-pixel levels
+    void orientPlanes(uint32_t planes[][3], bool rotate);          // Rotation and invert, per plane
+    void pushCanvasPlanes();
+    void pushPlanes(const uint32_t planes[][3]);
+    void loadPlanes();                 // Apply global brightness into the back buffer
+    void bamTick();
+    static void bamInterrupt(timer_callback_args_t* args);
+
+#if TINYSCREEN_STATS
+    TinyScreenStats stats;
+#endif
     
     // For backward compatibility - primary layer access
     AnimationLayer& primary() { return layers[0]; }
@@ -221,8 +713,16 @@ private:
 
     static PlayMode coercePlayMode(int mode);
 
+protected:
+    TinyScreenBase(AnimationLayer* layerStorage, uint8_t* orderStorage, uint8_t capacity,
+                   BlinkTimer* blinkStorage, uint8_t blinkCapacity,
+                   QueuedAnimation* queueStorage, uint8_t queueCapacity,
+                   GrayscaleState* grayStorage);
+
 public:
-    TinyScreen();
+    // Layers point into the owning object, so screens can't be copied
+    TinyScreenBase(const TinyScreenBase&) = delete;
+    TinyScreenBase& operator=(const TinyScreenBase&) = delete;
     
     //--- Initialization ---
     bool begin();
@@ -251,6 +751,7 @@ public:
     
     //--- Layered Animations ---
     int addLayer();  // Returns layer index, or -1 if full
+    int getLayerCapacity() const { return layerCapacity; }
     void playOnLayer(int layer, const Animation& animation, PlayMode mode = LOOP);
     void playOnLayer(int layer, const Animation& animation, PlayMode mode, int startFrame, int endFrame);
     void playOnLayer(int layer, const Animation& animation, int mode);
@@ -261,6 +762,27 @@ public:
     void pauseLayer(int layer);
     void resumeLayer(int layer);
     void stopLayer(int layer);
+    void setTimingModeOnLayer(int layer, TimingMode mode);
+    
+    //--- Layer Compositing ---
+    void setBlendModeOnLayer(int layer, BlendMode mode);
+    BlendMode getBlendModeOnLayer(int layer) const;
+    void setMaskOnLayer(int layer, const uint32_t mask[3]);   // BLEND_REPLACE area (nullptr = whole animation)
+    void setZOrderOnLayer(int layer, int z);                 // Lower z is further back (default 0)
+    int getZOrderOnLayer(int layer) const;
+    void setBrightnessOnLayer(int layer, int value);         // 0-255 (grayscale mode)
+    int getBrightnessOnLayer(int layer) const;
+    
+    //--- Grayscale (bit-plane modulation on a hardware timer; TinyScreenGray only) ---
+    // 2 bits per pixel (4 levels, refreshed at 35 Hz), 0 = back to on/off.
+    // False if no timer is free, the screen has no grayscale storage, or bits
+    // is above MAX_GRAY_BITS (3 and 4 bits would refresh at 15 and 7 Hz).
+    bool setGrayscale(int bits);
+    bool hasGrayscale() const { return gray != nullptr; }
+    int getGrayscale() const { return grayBits; }
+    int getMaxLevel() const { return grayBits ? (1 << grayBits) - 1 : 1; }
+    void setBrightness(int value);        // Global, 0-255
+    int getBrightness() const { return brightness; }
     
     //--- Playback Control (affects primary layer) ---
     void setSpeed(int speedMs);
@@ -270,6 +792,35 @@ public:
     void resume();
     void restoreOriginalSpeed();
     void stop();
+    void setTimingMode(TimingMode mode);  // What happens when update() runs late
+    TimingMode getTimingMode() const { return primary().getTimingMode(); }
+    
+    //--- Playlist (queued animations start inside update() as the previous one completes) ---
+    // A plain TinyScreen has no queue slots (MAX_QUEUE); declare TinyScreenT<N, B, Q> to use one
+    bool queue(const Animation& animation, PlayMode mode = ONCE, int loops = 0, int startFrame = 0, int endFrame = 0);
+    bool queueOnLayer(int layer, const Animation& animation, PlayMode mode = ONCE, int loops = 0,
+                      int startFrame = 0, int endFrame = 0);   // false if the queue is full
+    void clearQueue();
+    void clearQueueOnLayer(int layer);
+    int getQueueLength() const { return getQueueLengthOnLayer(0); }
+    int getQueueLengthOnLayer(int layer) const;
+    int getQueueCapacity() const { return queueCapacity; }
+    
+    //--- Timeline (master clock shared by following layers) ---
+    Timeline& getTimeline() { return timeline; }
+    void followTimeline();                            // Primary layer follows getTimeline()
+    void followTimelineOnLayer(int layer);
+    void followTimelineOnLayer(int layer, Timeline& master);
+    void leaveTimeline();                             // Back to the layer's own timing
+    void leaveTimelineOnLayer(int layer);
+    
+    //--- Seeking (jump within the play range without restarting) ---
+    void seekToFrame(int frameNum);                   // 1-based, like getCurrentFrame()
+    void seekToTime(unsigned long ms);                // Ms into one pass, in the play direction
+    void seekToFraction(float fraction);              // 0.0 = first frame shown, 1.0 = last
+    void seekToFrameOnLayer(int layer, int frameNum);
+    void seekToTimeOnLayer(int layer, unsigned long ms);
+    void seekToFractionOnLayer(int layer, float fraction);
     
     //--- Animation Position (offset animations on the display) ---
     void setPosition(int x, int y);
@@ -280,7 +831,9 @@ public:
     int getPositionYOnLayer(int layer) const;
     
     //--- Frame Update (call in loop!) ---
-    void update();
+    void update();                        // Returns immediately when nothing is due
+    bool needsUpdate() const;             // True if update() would change the display
+    unsigned long nextDeadline() const;   // Earliest millis() anything needs service
     
     //--- Canvas Mode (direct drawing) ---
     void beginDraw();
@@ -301,6 +854,7 @@ public:
     
     // Style control - use ON/OFF for simplicity (they're just hex constants)
     // stroke(ON) = turn on, stroke(OFF) = turn off
+    // In grayscale mode the brightest channel sets the level: stroke(128, 128, 128) is half
     void stroke(uint32_t color);              // Use ON, OFF, or hex color
     void stroke(uint8_t r, uint8_t g, uint8_t b);
     void fill(uint32_t color);                // Use ON, OFF, or hex color
@@ -364,14 +918,24 @@ public:
     
     AnimationState getState() const { return primary().getState(); }
     int getTotalFrames() const { return primary().getTotalFrames(); }
+    unsigned long getTotalDuration() const { return primary().getTotalDuration(); }
     int getCurrentFrame() const { return primary().getCurrentFrameNum(); }
     int getCurrentSpeed() const { return primary().getCurrentSpeed(); }
     int getStartFrame() const { return primary().getStartFrame(); }
     int getEndFrame() const { return primary().getEndFrame(); }
     
+#if TINYSCREEN_STATS
+    //--- Frame Statistics (only with TINYSCREEN_STATS=1) ---
+    const TinyScreenStats& getStats() const { return stats; }
+    void resetStats() { stats.reset(); }
+#endif
+    
     //--- Direct matrix access (advanced) ---
-    ArduinoLEDMatrix& getMatrix() { return matrix; }
-    void displayFrame(const uint32_t frame[3]);
+    // Writes through the returned matrix bypass the pushed-frame cache, so the next push always goes out
+    ArduinoLEDMatrix& getMatrix() { pushedFrameValid = false; return matrix; }
+    const ArduinoLEDMatrix& getMatrix() const { return matrix; }
+    void displayFrame(const uint32_t frame[3]);   // Always pushes, even if unchanged
+    unsigned long getSkippedPushes() const { return skippedPushes; }  // Unchanged frames not re-sent
     
     //--- Simple LED Control (digitalWrite-style) ---
     void led(int x, int y, bool state);           // Set LED at (x,y) on/off
@@ -386,20 +950,42 @@ public:
     void clearLeds();                             // Turn off all LEDs
     
     // Blink control (non-blocking, per-LED independent rates)
-    void blink(int x, int y, unsigned long rateMs);   // Blink LED at (x,y) every rateMs
-    void blink(int ledNum, unsigned long rateMs);     // Blink LED by index every rateMs
+    bool blink(int x, int y, unsigned long rateMs);   // Blink LED at (x,y) every rateMs, up to 65535 (false if all blink slots in use)
+    bool blink(int ledNum, unsigned long rateMs);     // Blink LED by index every rateMs
     void noBlink(int x, int y);                       // Stop blinking LED at (x,y), turn it OFF
     void noBlink(int ledNum);                         // Stop blinking LED by index
     void noBlink();                                   // Stop all blinking
+    
+    // Blink groups: every LED in a mask blinks together (one timer per rate)
+    bool blinkMask(const uint32_t mask[3], unsigned long rateMs, bool phaseLock = false);
+    void noBlinkMask(const uint32_t mask[3]);         // Stop blinking these LEDs, turn them OFF
     void updateBlinks();                              // Process blink timers (call in loop!)
+    int getBlinkCapacity() const { return blinkCapacity; }
     
 private:
     uint8_t ledBuffer[12][8];                     // Internal buffer for LED states
     bool ledBufferDirty;                          // Track if buffer needs display update
     
-    // Blink state (per-LED)
-    unsigned long blinkRate[12][8];               // 0 = not blinking, >0 = interval in ms
-    unsigned long lastBlinkTime[12][8];           // Last toggle time per LED
+    // Blink state: active blinkers only, min-heap on due time (storage owned by TinyScreenT)
+    BlinkTimer* blinks;
+    uint8_t blinkCapacity;
+    uint8_t blinkCount;
+    uint8_t blinkSlot[96];                        // Heap slot of each LED's blinker, NO_BLINK_SLOT if none
+    
+    // Blink groups (disjoint masks); groupFrame holds the members currently lit
+    BlinkGroup blinkGroups[MAX_BLINK_GROUPS];
+    uint32_t groupFrame[3];
+    
+    int findBlink(int ledNum) const {             // Heap slot of a blinking LED, -1 if none
+        return blinkSlot[ledNum] == NO_BLINK_SLOT ? -1 : blinkSlot[ledNum];
+    }
+    void placeBlink(int slot, const BlinkTimer& timer);   // Store a blinker and record its slot
+    void releaseFromGroups(int ledNum);           // Take an LED out of its group, keeping its state
+    bool updateBlinkGroups(unsigned long now);    // Returns true if any group toggled
+    void removeBlink(int slot);
+    void removeBlinksIn(const uint32_t mask[3]);  // Remove every blinking LED in a mask
+    void siftBlinkUp(int slot);
+    void siftBlinkDown(int slot);
     
     // Helper to convert linear index to x,y
     void indexToXY(int index, int& x, int& y);
@@ -408,6 +994,52 @@ private:
     void canvasBufferToFrame(uint32_t frame[3]);
 };
 
+//------------------------------------------------------------------------------
+// TinyScreenT<N> - TinyScreen with room for N animation layers
+//------------------------------------------------------------------------------
+//
+//   TinyScreen screen;          // 5 layers (MAX_LAYERS), 32 blinking LEDs (MAX_BLINKS)
+//   TinyScreenT<1> screen;      // Single animation
+//   TinyScreenT<12> screen;     // Large installations
+//   TinyScreenT<5, 96> screen;  // Every LED can blink (8 bytes per blinker)
+//   TinyScreenT<1, 8> screen;   // At most 8 blinking LEDs, smallest RAM use
+//   TinyScreenT<2, 16, 8> screen;  // 8 queued animations per layer (a plain TinyScreen has no queue)
+//   TinyScreenGray screen;      // TinyScreen plus setGrayscale() (bit-planes and a timer)
+//
+
+// Fixed storage for Count entries; Count 0 takes no RAM
+template<typename T, int Count>
+struct SlotArray {
+    T items[Count];
+    T* data() { return items; }
+};
+
+template<typename T>
+struct SlotArray<T, 0> {
+    T* data() { return nullptr; }
+};
+
+template<int N, int B = MAX_BLINKS, int Q = MAX_QUEUE, bool Gray = false>
+class TinyScreenT : public TinyScreenBase {
+    static_assert(N >= 1 && N <= 32, "TinyScreenT supports 1 to 32 layers");
+    static_assert(B >= 1 && B <= 96, "TinyScreenT supports 1 to 96 blinking LEDs");
+    static_assert(Q >= 0 && Q <= 255, "TinyScreenT supports 0 to 255 queued animations per layer");
+
+private:
+    AnimationLayer layerStorage[N];
+    uint8_t orderStorage[N];
+    BlinkTimer blinkStorage[B];
+    SlotArray<QueuedAnimation, N * Q> queueStorage;
+    SlotArray<GrayscaleState, Gray ? 1 : 0> grayStorage;
+
+public:
+    TinyScreenT() : TinyScreenBase(layerStorage, orderStorage, N, blinkStorage, B, queueStorage.data(), Q,
+                                   grayStorage.data()) {}
+};
+
+using TinyScreen = TinyScreenT<MAX_LAYERS>;
+using TinyScreenGray = TinyScreenT<MAX_LAYERS, MAX_BLINKS, MAX_QUEUE, true>;
+
 //------------------------------------------------------------------------------
 // Backward Compatibility Aliases
 //------------------------------------------------------------------------------
@@ -419,7 +1051,8 @@ using TinyFilmFestival = TinyScreen;
 // Standalone LED Functions (digitalWrite-style convenience)
 //------------------------------------------------------------------------------
 
-// These functions use a default internal TinyScreen instance
+// These functions use a default internal screen, which can blink every LED
+// (TinyScreenT<MAX_LAYERS, 96>)
 // Call ledBegin() once in setup(), then use ledWrite() like digitalWrite()
 void ledBegin();                                  // Initialize the LED matrix
 void ledWrite(int x, int y, bool state);          // Set LED at (x,y) - like digitalWrite
@@ -435,10 +1068,12 @@ void ledBlink(int ledNum, unsigned long rateMs);   // Blink LED by index every r
 void ledNoBlink(int x, int y);                     // Stop blinking LED at (x,y)
 void ledNoBlink(int ledNum);                       // Stop blinking LED by index
 void ledNoBlink();                                 // Stop all blinking
+void ledBlinkMask(const uint32_t mask[3], unsigned long rateMs, bool phaseLock = false);  // Blink a group of LEDs together
+void ledNoBlinkMask(const uint32_t mask[3]);       // Stop blinking a group, turn it OFF
 void ledUpdate();                                  // Process blink timers (call in loop!)
 
-// Get the internal TinyScreen instance (for mixing with other features)
-TinyScreen& getLedMatrix();
+// Get the internal screen instance (for mixing with other features)
+TinyScreenBase& getLedMatrix();
 
 //------------------------------------------------------------------------------
 // Animation Utilities - Smooth value control